@@ -0,0 +1,439 @@
+#include "Game.h"
+#include "Bomberman.h"
+#include "Constants.h"
+#include "LoopbackTransport.h"
+#include "Random.h"
+#include "WorkerPool.h"
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+ * Runs many headless matches in parallel and writes the result of every match.
+ *
+ * Every combination of a map and a seed is one match, the matches are independent games spread across
+ * the threads of a worker pool. A match is fully determined by its map and seed, so the results do not
+ * depend on the number of threads and are always written in the order of the maps and seeds.
+ * The results are written as CSV or JSON to stdout or a file, a summary of the wins is printed to stderr.
+ *
+ * With --network every match is played as a network match of two peers connected by a loopback transport,
+ * the players controlled by scripted inputs. The peers have to end in the same state, the matches where they
+ * don't are listed in the summary and the runner exits with status 1. The transport can delay and drop packets,
+ * so that the peers predict inputs and roll back.
+ */
+
+namespace {
+
+/* Stream of the scripted player inputs of network matches, away from the streams the game uses */
+const std::uint64_t INPUT_STREAM = 1 << 20;
+/* Number of ticks a scripted input is held for */
+const unsigned int INPUT_HOLD_TICKS = 20;
+
+struct Options {
+	std::vector<std::string> maps;
+	std::uint64_t firstSeed = 1;
+	std::uint64_t lastSeed = 1;
+	/*! Threads running matches, 0 uses one thread per hardware thread. */
+	unsigned int threads = 0;
+	unsigned int maxTicks = Constants::HEADLESS_MAX_TICKS;
+	bool json = false;
+	/*! File the results are written to, stdout if empty. */
+	std::string outputFile;
+	/*! Whether the matches are played as network matches of two peers. */
+	bool network = false;
+	/*! Latency of the packets between the peers of network matches. */
+	unsigned int latency = 0;
+	/*! Probability to drop a packet between the peers of network matches. */
+	double packetLoss = 0.0;
+	/*! Rollback ticks of network matches, the default of the game if empty. */
+	std::string rollbackTicks;
+};
+
+struct BombermanResult {
+	std::string name;
+	int score;
+	int health;
+};
+
+struct MatchResult {
+	std::string map;
+	std::uint64_t seed;
+	/*! Whether the game loaded, the other fields are only set for loaded games. */
+	bool loaded = false;
+	/*! Name of the last bomberman standing, "none" for a draw or a match that reached the tick limit. */
+	std::string winner;
+	unsigned int ticks = 0;
+	std::vector<BombermanResult> bombermen;
+	/*! Whether the two peers of a network match ended in different states. */
+	bool desynchronized = false;
+	/*! Number of rollbacks of both peers of a network match. */
+	unsigned int rollbacks = 0;
+};
+
+/*!
+ * Plays a match to its end or the tick limit.
+ */
+void runMatch(MatchResult& result, unsigned int maxTicks) {
+	Game game;
+	game.setHeadless(true);
+	game.setQuiet(true);
+	game.setSeed(result.seed);
+	game.loadConfigEntry("map", result.map);
+	//The matches already occupy all threads, the AI of a match is planned on the thread of the match
+	game.loadConfigEntry("aiThreads", "1");
+	if (!game.load(nullptr)) {
+		return;
+	}
+	result.loaded = true;
+
+	while (!game.isEndOfGame() && game.getTick() < maxTicks) {
+		game.update();
+	}
+
+	const Bomberman* winner = game.getWinner();
+	result.winner = winner ? game.getBombermanName(winner) : "none";
+	result.ticks = game.getTick();
+	for (const Bomberman* bomberman : game.getBombermen()) {
+		result.bombermen.push_back(BombermanResult{ game.getBombermanName(bomberman), bomberman->getScore(), bomberman->getHealth() });
+	}
+}
+
+/*!
+ * Returns the scripted input of a player of a network match, a random combination of the Player::Input bits
+ * held for INPUT_HOLD_TICKS ticks. It only depends on the seed, the player and the tick.
+ */
+Uint8 getScriptedInput(std::uint64_t seed, char playerId, unsigned int tick) {
+	Random random(seed, INPUT_STREAM + static_cast<std::uint64_t>(playerId) * 65536 + tick / INPUT_HOLD_TICKS);
+	return static_cast<Uint8>(random() & 0x1F);
+}
+
+/*!
+ * Returns the tick and the score, health and position of every bomberman, which both peers of a match must agree on.
+ */
+std::string getMatchState(const Game& game) {
+	std::ostringstream state;
+	state << game.getTick();
+	for (const Bomberman* bomberman : game.getBombermen()) {
+		state << " " << bomberman->getScore() << "/" << bomberman->getHealth() << "/" << bomberman->getX() << "," << bomberman->getY();
+	}
+	return state.str();
+}
+
+/*!
+ * Plays a match as a network match of two peers on the calling thread, the first peer controls player A
+ * and the second one player B. The result is the one of the first peer, peers that stall for
+ * Constants::LOCKSTEP_TIMEOUT_MS count as desynchronized.
+ */
+void runNetworkMatch(MatchResult& result, const Options& options) {
+	const unsigned int maxTicks = options.maxTicks;
+	const char playerIds[2] = { 'A', 'B' };
+	auto transports = LoopbackTransport::createPair();
+	transports.first->setLatency(options.latency);
+	transports.second->setLatency(options.latency);
+	if (options.packetLoss > 0.0) {
+		transports.first->setPacketLoss(options.packetLoss, result.seed * 2);
+		transports.second->setPacketLoss(options.packetLoss, result.seed * 2 + 1);
+	}
+	std::unique_ptr<Transport> peerTransports[2] = { std::move(transports.first), std::move(transports.second) };
+	std::unique_ptr<Game> peers[2];
+	for (int i = 0; i < 2; i++) {
+		peers[i].reset(new Game());
+		Game& game = *peers[i];
+		game.setHeadless(true);
+		game.setQuiet(true);
+		game.setSeed(result.seed);
+		game.loadConfigEntry("map", result.map);
+		game.loadConfigEntry("aiThreads", "1");
+		game.loadConfigEntry("lockstepPlayers", std::string(1, playerIds[i]));
+		if (!options.rollbackTicks.empty()) {
+			game.loadConfigEntry("rollbackTicks", options.rollbackTicks);
+		}
+		game.setTransport(std::move(peerTransports[i]));
+		if (!game.load(nullptr)) {
+			return;
+		}
+	}
+	result.loaded = true;
+
+	//The peers take turns, a finished peer keeps answering the other one until both are finished
+	const int timeoutMs = Constants::LOCKSTEP_TIMEOUT_MS;
+	auto lastProgressTime = std::chrono::steady_clock::now();
+	bool finished[2] = { false, false };
+	while (!finished[0] || !finished[1]) {
+		bool simulated = false;
+		for (int i = 0; i < 2; i++) {
+			Game& game = *peers[i];
+			game.setLocalInput(playerIds[i], getScriptedInput(result.seed, playerIds[i], game.getTick()));
+			if (game.isNextTickReady() && !game.isEndOfGame() && game.getTick() < maxTicks) {
+				game.update();
+				simulated = true;
+			}
+			finished[i] = (game.isEndOfGame() || game.getTick() >= maxTicks) && game.isTickConfirmed();
+		}
+		if (simulated) {
+			lastProgressTime = std::chrono::steady_clock::now();
+		} else if (std::chrono::steady_clock::now() - lastProgressTime > std::chrono::milliseconds(timeoutMs)) {
+			//A peer that rejected the other one never answers it, the waiting peer would wait forever
+			std::cerr << "Match " << result.map << " " << result.seed << " stalled at tick " << peers[0]->getTick()
+				<< " and " << peers[1]->getTick() << std::endl;
+			break;
+		} else {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+
+	const Game& game = *peers[0];
+	const Bomberman* winner = game.getWinner();
+	result.winner = winner ? game.getBombermanName(winner) : "none";
+	result.ticks = game.getTick();
+	for (const Bomberman* bomberman : game.getBombermen()) {
+		result.bombermen.push_back(BombermanResult{ game.getBombermanName(bomberman), bomberman->getScore(), bomberman->getHealth() });
+	}
+	result.desynchronized = !finished[0] || !finished[1] || getMatchState(*peers[0]) != getMatchState(*peers[1]);
+	result.rollbacks = peers[0]->getRollbackCount() + peers[1]->getRollbackCount();
+}
+
+/*!
+ * Returns a CSV field, quoted if it contains a separator or a quote.
+ */
+std::string csvField(const std::string& value) {
+	if (value.find_first_of(",\"\n") == std::string::npos) {
+		return value;
+	}
+	std::string quoted = "\"";
+	for (char c : value) {
+		if (c == '"') {
+			quoted += '"';
+		}
+		quoted += c;
+	}
+	return quoted + "\"";
+}
+
+/*!
+ * Returns a quoted JSON string.
+ */
+std::string jsonString(const std::string& value) {
+	std::string quoted = "\"";
+	for (char c : value) {
+		if (c == '"' || c == '\\') {
+			quoted += '\\';
+		}
+		quoted += c;
+	}
+	return quoted + "\"";
+}
+
+/*!
+ * Writes one row per match:
+ * map,seed,loaded,winner,ticks,scores
+ * where scores lists "name:score:health" of every bomberman separated by semicolons.
+ */
+void writeCsv(std::ostream& output, const std::vector<MatchResult>& results) {
+	output << "map,seed,loaded,winner,ticks,scores" << std::endl;
+	for (auto& result : results) {
+		std::ostringstream scores;
+		for (size_t i = 0; i < result.bombermen.size(); i++) {
+			const BombermanResult& bomberman = result.bombermen[i];
+			scores << (i > 0 ? ";" : "") << bomberman.name << ":" << bomberman.score << ":" << bomberman.health;
+		}
+		output << csvField(result.map) << "," << result.seed << "," << (result.loaded ? 1 : 0) << ","
+			<< csvField(result.winner) << "," << result.ticks << "," << csvField(scores.str()) << std::endl;
+	}
+}
+
+/*!
+ * Writes an array with an object per match.
+ */
+void writeJson(std::ostream& output, const std::vector<MatchResult>& results) {
+	output << "[" << std::endl;
+	for (size_t i = 0; i < results.size(); i++) {
+		const MatchResult& result = results[i];
+		output << "\t{ \"map\": " << jsonString(result.map) << ", \"seed\": " << result.seed
+			<< ", \"loaded\": " << (result.loaded ? "true" : "false")
+			<< ", \"winner\": " << jsonString(result.winner) << ", \"ticks\": " << result.ticks << ", \"scores\": [";
+		for (size_t j = 0; j < result.bombermen.size(); j++) {
+			const BombermanResult& bomberman = result.bombermen[j];
+			output << (j > 0 ? ", " : " ") << "{ \"name\": " << jsonString(bomberman.name)
+				<< ", \"score\": " << bomberman.score << ", \"health\": " << bomberman.health << " }";
+		}
+		output << (result.bombermen.empty() ? "] }" : " ] }") << (i + 1 < results.size() ? "," : "") << std::endl;
+	}
+	output << "]" << std::endl;
+}
+
+/*!
+ * Prints the number of wins of every bomberman name, the match throughput and the desynchronized network matches.
+ * Returns the number of desynchronized matches.
+ */
+int printSummary(const std::vector<MatchResult>& results, double seconds) {
+	std::map<std::string, int> wins;
+	int failed = 0;
+	int desynchronized = 0;
+	unsigned int rollbacks = 0;
+	for (auto& result : results) {
+		rollbacks += result.rollbacks;
+		if (result.loaded) {
+			wins[result.winner]++;
+		} else {
+			failed++;
+		}
+		if (result.desynchronized) {
+			std::cerr << "Match " << result.map << " " << result.seed << " desynchronized!" << std::endl;
+			desynchronized++;
+		}
+	}
+	std::cerr << "Played " << results.size() - failed << " matches in " << seconds << " s ("
+		<< (seconds > 0 ? results.size() / seconds : 0.0) << " matches/s)" << std::endl;
+	for (auto& win : wins) {
+		std::cerr << "  " << win.first << ": " << win.second << std::endl;
+	}
+	if (failed > 0) {
+		std::cerr << failed << " matches failed to load" << std::endl;
+	}
+	if (rollbacks > 0) {
+		std::cerr << "Network matches rolled back " << rollbacks << " times" << std::endl;
+	}
+	if (desynchronized > 0) {
+		std::cerr << desynchronized << " network matches desynchronized" << std::endl;
+	}
+	return desynchronized;
+}
+
+/*!
+ * Splits a comma separated list.
+ */
+std::vector<std::string> splitList(const std::string& list) {
+	std::vector<std::string> items;
+	std::istringstream listStream(list);
+	std::string item;
+	while (std::getline(listStream, item, ',')) {
+		if (!item.empty()) {
+			items.push_back(item);
+		}
+	}
+	return items;
+}
+
+Options parseOptions(int argc, char** argv) {
+	Options options;
+	for (int i = 1; i < argc; i++) {
+		const std::string argument = argv[i];
+		if (argument == "--maps" && i + 1 < argc) {
+			options.maps = splitList(argv[++i]);
+		} else if (argument == "--seeds" && i + 1 < argc) {
+			//Either a single seed or an inclusive range "first-last"
+			const std::string range = argv[++i];
+			const size_t separator = range.find('-');
+			options.firstSeed = std::stoull(range.substr(0, separator));
+			options.lastSeed = separator == std::string::npos ? options.firstSeed : std::stoull(range.substr(separator + 1));
+		} else if (argument == "--threads" && i + 1 < argc) {
+			options.threads = static_cast<unsigned int>(std::stoul(argv[++i]));
+		} else if (argument == "--max-ticks" && i + 1 < argc) {
+			options.maxTicks = static_cast<unsigned int>(std::stoul(argv[++i]));
+		} else if (argument == "--format" && i + 1 < argc) {
+			const std::string format = argv[++i];
+			if (format != "csv" && format != "json") {
+				throw std::runtime_error("Unknown format " + format + "! Use csv or json");
+			}
+			options.json = format == "json";
+		} else if (argument == "--output" && i + 1 < argc) {
+			options.outputFile = argv[++i];
+		} else if (argument == "--network") {
+			options.network = true;
+		} else if (argument == "--latency" && i + 1 < argc) {
+			options.latency = static_cast<unsigned int>(std::stoul(argv[++i]));
+		} else if (argument == "--packet-loss" && i + 1 < argc) {
+			options.packetLoss = std::stod(argv[++i]);
+		} else if (argument == "--rollback-ticks" && i + 1 < argc) {
+			options.rollbackTicks = argv[++i];
+		} else {
+			std::ostringstream oss;
+			oss << "Unknown argument " << argument << "! Usage: " << argv[0]
+				<< " --maps file[,file...] [--seeds first[-last]] [--threads n] [--max-ticks n] [--format csv|json] [--output file]"
+				<< " [--network [--latency ms] [--packet-loss probability] [--rollback-ticks n]]";
+			throw std::runtime_error(oss.str());
+		}
+	}
+	if (options.maps.empty()) {
+		throw std::runtime_error("No maps specified! Use --maps file[,file...]");
+	}
+	if (options.lastSeed < options.firstSeed) {
+		throw std::runtime_error("Invalid seed range, the last seed is lower than the first one");
+	}
+	if (options.packetLoss < 0.0 || options.packetLoss >= 1.0) {
+		throw std::runtime_error("Invalid packet loss, expected a probability from 0 up to 1");
+	}
+	return options;
+}
+
+}
+
+int main(int argc, char** argv) {
+	try {
+		const Options options = parseOptions(argc, argv);
+
+		std::vector<MatchResult> results;
+		for (auto& map : options.maps) {
+			for (std::uint64_t seed = options.firstSeed; ; seed++) {
+				MatchResult result;
+				result.map = map;
+				result.seed = seed;
+				results.push_back(result);
+				if (seed == options.lastSeed) {
+					break;
+				}
+			}
+		}
+
+		//Every match writes only its own result, the results keep the order of the maps and seeds
+		WorkerPool pool(options.threads);
+		std::cerr << "Running " << results.size() << " matches on " << pool.getThreadCount() << " threads" << std::endl;
+		const auto start = std::chrono::steady_clock::now();
+		pool.run(results.size(), [&results, &options](std::size_t index) {
+			//Jobs of the pool must not throw, a failed match is reported and the others keep running
+			try {
+				if (options.network) {
+					runNetworkMatch(results[index], options);
+				} else {
+					runMatch(results[index], options.maxTicks);
+				}
+			} catch (const std::exception& error) {
+				results[index].loaded = false;
+				std::cerr << "Match " << results[index].map << " " << results[index].seed << " failed! " << error.what() << std::endl;
+			}
+		});
+		const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+		std::ofstream outputFile;
+		if (!options.outputFile.empty()) {
+			outputFile.open(options.outputFile);
+			if (!outputFile) {
+				throw std::runtime_error("Failed to open the output file " + options.outputFile);
+			}
+		}
+		std::ostream& output = options.outputFile.empty() ? std::cout : outputFile;
+		if (options.json) {
+			writeJson(output, results);
+		} else {
+			writeCsv(output, results);
+		}
+
+		if (printSummary(results, elapsed.count()) > 0) {
+			return 1;
+		}
+	} catch (const std::exception& error) {
+		std::cerr << error.what() << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,407 @@
+#include "Game.h"
+#include "Map.h"
+#include "Tile.h"
+#include "Bomb.h"
+#include "Entity.h"
+#include "EntityManager.h"
+#include "Collision.h"
+#include "Pathfinder.h"
+#include "Random.h"
+#include "WorldSnapshot.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+/*
+ * Headless benchmarks of the engine hot paths.
+ *
+ * Every benchmark loads one of the example maps into a headless game with a fixed seed,
+ * so the measured work is identical between runs and machines. Results are printed to stdout as CSV:
+ * benchmark,map,size,iterations,min_ns,median_ns
+ * where the times are nanoseconds per iteration of the best and the median sample.
+ * Must be run from the repository root so that the example maps are found.
+ */
+
+namespace {
+
+const std::uint64_t SEED = 12345;
+
+/* The example maps that load, smallMap2p contains an invalid map character */
+const char* const ALL_MAPS[] = {
+	"classicDestroyedMap2p", "classicDestroyedMap2p2c", "classicDestroyedMap4c", "classicDestroyedMapAItest",
+	"classicMap2p", "maze2p1c", "maze4c", "testMap", "wideMap"
+};
+
+/* Maps with four computer players */
+const char* const COMPUTER_MAPS[] = { "classicDestroyedMap4c", "maze4c" };
+
+/*!
+ * Stream buffer that discards everything, used to silence the game logging while games are loaded.
+ */
+class NullBuffer : public std::streambuf {
+protected:
+	int overflow(int c) override { return c; }
+};
+
+struct Options {
+	int samples = 7;
+	std::string filter;
+};
+
+/*!
+ * Runs benchmarks and prints their results.
+ */
+class BenchmarkRunner {
+private:
+	Options options;
+	std::ostream& output;
+public:
+	BenchmarkRunner(const Options& options, std::ostream& output) : options(options), output(output) {
+		output << "benchmark,map,size,iterations,min_ns,median_ns" << std::endl;
+	}
+
+	/*!
+	 * Whether a benchmark is selected by the --filter option.
+	 */
+	bool isSelected(const std::string& name) const {
+		return options.filter.empty() || name.find(options.filter) != std::string::npos;
+	}
+
+	/*!
+	 * Measures a benchmark and prints one result row.
+	 *
+	 * \param name Benchmark name.
+	 * \param map Name of the map the benchmark runs on.
+	 * \param size Benchmark specific size parameter (entity count, chain length...).
+	 * \param iterations Number of iterations a single sample performs, the times are reported per iteration.
+	 * \param setup Called before every sample, not measured.
+	 * \param sample Performs one sample of the measured work.
+	 */
+	void measure(const std::string& name, const std::string& map, int size, int iterations,
+		const std::function<void()>& setup, const std::function<void()>& sample) {
+		std::vector<double> times;
+		for (int i = 0; i < options.samples; i++) {
+			setup();
+			const auto start = std::chrono::steady_clock::now();
+			sample();
+			const auto end = std::chrono::steady_clock::now();
+			times.push_back(std::chrono::duration<double, std::nano>(end - start).count() / iterations);
+		}
+		std::sort(times.begin(), times.end());
+		output << name << "," << map << "," << size << "," << iterations << ","
+			<< static_cast<long long>(times.front()) << "," << static_cast<long long>(times[times.size() / 2]) << std::endl;
+	}
+};
+
+/*!
+ * Loads an example map into a new headless game with the benchmark seed.
+ */
+std::unique_ptr<Game> loadGame(const std::string& mapName) {
+	std::unique_ptr<Game> game(new Game());
+	game->loadConfigEntry("headless", "1");
+	game->loadConfigEntry("map", "examples/" + mapName + ".txt");
+	game->setSeed(SEED);
+	if (!game->load(nullptr)) {
+		std::ostringstream oss;
+		oss << "Failed to load the map " << mapName << "!";
+		throw std::runtime_error(oss.str());
+	}
+	return game;
+}
+
+/*!
+ * Returns the size of the map in pixels.
+ */
+SDL_Rect getMapBounds(Map& map) {
+	SDL_Rect bounds{ 0, 0, 0, 0 };
+	for (Tile& tile : map.getTiles()) {
+		bounds.w = std::max(bounds.w, tile.getX() + tile.getWidth());
+		bounds.h = std::max(bounds.h, tile.getY() + tile.getHeight());
+	}
+	return bounds;
+}
+
+std::vector<Tile*> getWalkableTiles(Map& map) {
+	std::vector<Tile*> walkableTiles;
+	for (Tile& tile : map.getTiles()) {
+		if (map.isWalkable(tile.getIndex())) {
+			walkableTiles.push_back(&tile);
+		}
+	}
+	return walkableTiles;
+}
+
+/* Same target condition as the computer uses when looking for walls to destroy */
+struct TileHasAWallNextToIt {
+	std::vector<Tile*>& neighbours;
+
+	template<typename MapView>
+	bool operator() (Tile* tile, MapView& map) const {
+		map.getExistingNeighbourTiles(tile, true, neighbours);
+		for (Tile* neighbour : neighbours) {
+			if (map.isWall(neighbour->getIndex()) && !map.isIndestructible(neighbour->getIndex())) {
+				return true;
+			}
+		}
+		return false;
+	}
+};
+
+/*!
+ * Collision queries against a growing number of entities on top of the map walls.
+ */
+void benchmarkCollision(BenchmarkRunner& runner) {
+	const std::string map = "classicDestroyedMap4c";
+	const int queryCount = 10000;
+	for (const int entityCount : { 0, 16, 64, 256, 1024 }) {
+		std::unique_ptr<Game> game = loadGame(map);
+		Random random(SEED, 0);
+		const SDL_Rect bounds = getMapBounds(*game->map);
+		const int width = bounds.w;
+		const int height = bounds.h;
+		for (int i = 0; i < entityCount; i++) {
+			game->entityManager->addEntity(new Entity(TextureRegion(), random.getIntInRange(0, width - 1), random.getIntInRange(0, height - 1),
+				Constants::BOMBERMAN_SIZE, Constants::BOMBERMAN_SIZE));
+		}
+		std::vector<SDL_Rect> queries;
+		for (int i = 0; i < queryCount; i++) {
+			queries.push_back(SDL_Rect{ random.getIntInRange(0, width - 1), random.getIntInRange(0, height - 1),
+				Constants::BOMBERMAN_SIZE, Constants::BOMBERMAN_SIZE });
+		}
+
+		std::vector<std::shared_ptr<Entity>> result;
+		int collisions = 0;
+		runner.measure("collision", map, entityCount, queryCount, [] {}, [&] {
+			for (const SDL_Rect& query : queries) {
+				collisions += Collision::checkCollision(query, nullptr, &result, nullptr, game.get());
+			}
+		});
+	}
+}
+
+/*!
+ * A* searches between random pairs of walkable tiles.
+ */
+void benchmarkPathfinding(BenchmarkRunner& runner, const std::string& map) {
+	const int pathCount = 200;
+	std::unique_ptr<Game> game = loadGame(map);
+	const std::vector<Tile*> walkableTiles = getWalkableTiles(*game->map);
+	if (walkableTiles.empty()) {
+		return;
+	}
+	Random random(SEED, 0);
+	std::vector<std::pair<Tile*, Tile*>> pairs;
+	for (int i = 0; i < pathCount; i++) {
+		pairs.emplace_back(walkableTiles[random.getIntInRange(0, static_cast<int>(walkableTiles.size()) - 1)],
+			walkableTiles[random.getIntInRange(0, static_cast<int>(walkableTiles.size()) - 1)]);
+	}
+
+	Pathfinder pathfinder;
+	size_t pathLengths = 0;
+	runner.measure("astar", map, static_cast<int>(game->map->getTiles().size()), pathCount, [] {}, [&] {
+		for (auto& pair : pairs) {
+			pathLengths += pathfinder.findPath(*game->map, pair.first, pair.second).size();
+		}
+	});
+}
+
+/*!
+ * Breadth first searches for the nearest destructible wall from random walkable tiles.
+ */
+void benchmarkBreadthFirstSearch(BenchmarkRunner& runner, const std::string& map) {
+	const int searchCount = 200;
+	std::unique_ptr<Game> game = loadGame(map);
+	const std::vector<Tile*> walkableTiles = getWalkableTiles(*game->map);
+	if (walkableTiles.empty()) {
+		return;
+	}
+	Random random(SEED, 0);
+	std::vector<Tile*> starts;
+	for (int i = 0; i < searchCount; i++) {
+		starts.push_back(walkableTiles[random.getIntInRange(0, static_cast<int>(walkableTiles.size()) - 1)]);
+	}
+
+	Pathfinder pathfinder;
+	std::vector<Tile*> neighbours;
+	int found = 0;
+	runner.measure("bfs", map, static_cast<int>(game->map->getTiles().size()), searchCount, [&] { random.seed(SEED, 0); }, [&] {
+		for (Tile* start : starts) {
+			found += pathfinder.breadthFirstSearch(start, *game->map, TileHasAWallNextToIt{ neighbours }, random) != nullptr;
+		}
+	});
+	//A search that never reaches a target floods the whole map, which is not the work the computer does
+	if (found == 0) {
+		std::cerr << "Warning: no bfs search on " << map << " found a destructible wall" << std::endl;
+	}
+}
+
+/*!
+ * Copies of the whole map.
+ */
+void benchmarkMapCopy(BenchmarkRunner& runner, const std::string& map) {
+	const int copyCount = 100;
+	std::unique_ptr<Game> game = loadGame(map);
+	Map copy;
+	runner.measure("map_copy", map, static_cast<int>(game->map->getTiles().size()), copyCount, [] {}, [&] {
+		for (int i = 0; i < copyCount; i++) {
+			copy = *game->map;
+		}
+	});
+}
+
+/*!
+ * A chain reaction of bombs placed on consecutive destructible tiles, triggered by exploding the first one.
+ * The walls under the bombs are removed so that every bomb reaches its neighbours.
+ */
+void benchmarkExplosionChain(BenchmarkRunner& runner) {
+	const std::string map = "classicMap2p";
+	for (const int bombCount : { 1, 8, 32, 128 }) {
+		std::unique_ptr<Game> game;
+		Bomb* firstBomb = nullptr;
+		const auto setup = [&] {
+			game.reset();
+			game = loadGame(map);
+			firstBomb = nullptr;
+			int placedBombs = 0;
+			for (Tile& tile : game->map->getTiles()) {
+				if (placedBombs == bombCount) {
+					break;
+				}
+				if (tile.isIndestructible()) {
+					continue;
+				}
+				tile.setWall(false);
+				Bomb* bomb = new Bomb(Constants::DEFAULT_BOMB_POWER_LEVEL, tile.getX(), tile.getY());
+				bomb->centerInRect(*tile.getRect());
+				game->entityManager->addEntity(bomb);
+				if (!firstBomb) {
+					firstBomb = bomb;
+				}
+				placedBombs++;
+			}
+		};
+		runner.measure("explosion_chain", map, bombCount, 1, setup, [&] {
+			firstBomb->explode(game.get());
+		});
+	}
+}
+
+/*!
+ * Full game ticks of a match between four computers.
+ */
+void benchmarkTick(BenchmarkRunner& runner, const std::string& map) {
+	const int warmUpTicks = 60;
+	const int tickCount = 600;
+	std::unique_ptr<Game> game;
+	const auto setup = [&] {
+		game.reset();
+		game = loadGame(map);
+		for (int i = 0; i < warmUpTicks; i++) {
+			game->update();
+		}
+	};
+	runner.measure("tick", map, Constants::PLAYER_OR_COMPUTER_MAX_COUNT, tickCount, setup, [&] {
+		for (int i = 0; i < tickCount; i++) {
+			game->update();
+		}
+	});
+}
+
+/*!
+ * Capturing and restoring the whole simulation state in the middle of a match between four computers.
+ */
+void benchmarkSnapshot(BenchmarkRunner& runner, const std::string& map) {
+	const int warmUpTicks = 600;
+	const int iterations = 1000;
+	std::unique_ptr<Game> game = loadGame(map);
+	for (int i = 0; i < warmUpTicks; i++) {
+		game->update();
+	}
+	WorldSnapshot snapshot;
+	game->captureSnapshot(snapshot);
+	const int entityCount = static_cast<int>(snapshot.entities.size());
+
+	WorldSnapshot capture;
+	runner.measure("snapshot_capture", map, entityCount, iterations, [] {}, [&] {
+		for (int i = 0; i < iterations; i++) {
+			game->captureSnapshot(capture);
+		}
+	});
+	runner.measure("snapshot_restore", map, entityCount, iterations, [] {}, [&] {
+		for (int i = 0; i < iterations; i++) {
+			game->restoreSnapshot(snapshot);
+		}
+	});
+}
+
+Options parseOptions(int argc, char** argv) {
+	Options options;
+	for (int i = 1; i < argc; i++) {
+		const std::string argument = argv[i];
+		if (argument == "--samples" && i + 1 < argc) {
+			options.samples = std::max(1, std::stoi(argv[++i]));
+		} else if (argument == "--filter" && i + 1 < argc) {
+			options.filter = argv[++i];
+		} else {
+			std::ostringstream oss;
+			oss << "Unknown argument " << argument << "! Usage: " << argv[0] << " [--samples n] [--filter name]";
+			throw std::runtime_error(oss.str());
+		}
+	}
+	return options;
+}
+
+}
+
+int main(int argc, char** argv) {
+	//The results are written to the original stdout, the game logging is discarded
+	std::ostream output(std::cout.rdbuf());
+	NullBuffer nullBuffer;
+	try {
+		const Options options = parseOptions(argc, argv);
+		std::cout.rdbuf(&nullBuffer);
+
+		BenchmarkRunner runner(options, output);
+		if (runner.isSelected("collision")) {
+			benchmarkCollision(runner);
+		}
+		for (const char* map : ALL_MAPS) {
+			if (runner.isSelected("astar")) {
+				benchmarkPathfinding(runner, map);
+			}
+			if (runner.isSelected("bfs")) {
+				benchmarkBreadthFirstSearch(runner, map);
+			}
+			if (runner.isSelected("map_copy")) {
+				benchmarkMapCopy(runner, map);
+			}
+		}
+		if (runner.isSelected("explosion_chain")) {
+			benchmarkExplosionChain(runner);
+		}
+		for (const char* map : COMPUTER_MAPS) {
+			if (runner.isSelected("tick")) {
+				benchmarkTick(runner, map);
+			}
+			if (runner.isSelected("snapshot")) {
+				benchmarkSnapshot(runner, map);
+			}
+		}
+
+	} catch (const std::exception& error) {
+		std::cout.rdbuf(output.rdbuf());
+		std::cerr << error.what() << std::endl;
+		return 1;
+	}
+	std::cout.rdbuf(output.rdbuf());
+	return 0;
+}
@@ -2,10 +2,12 @@
 
 #include "TextureManager.h"
 #include "DamageCollider.h"
-#include "ExplosionParticle.h"
+#include "ParticleSystem.h"
 #include "Collision.h"
 #include "Bomberman.h"
+#include "EntityManager.h"
 #include "Map.h"
+#include "WorldSnapshot.h"
 
 #include <iostream>
 #include <string>
@@ -13,6 +15,7 @@
 Bomb::Bomb(int powerLevel, int x, int y)
 : Entity(TextureManager::bombFrame1, x, y, Constants::BOMB_SIZE, Constants::BOMB_SIZE),
 bombPowerLevel(powerLevel) {
+	kind = BOMB;
 	sprite.setAnimated(true);
 	sprite.setEffect(Sprite::BREATHING, Constants::BOMB_BREATHING_EFFECT_DURATION);
 	sprite.setAnimationSpeed(5);
@@ -22,7 +25,7 @@ bombPowerLevel(powerLevel) {
 }
 
 Bomb::Bomb(int powerLevel, int x, int y, Bomberman* bomberman) : Bomb(powerLevel, x, y) {
-	this->bomberman = bomberman;
+	this->bomberman = bomberman->getHandle();
 	bomberman->setAvailableBombs(bomberman->getAvailableBombs() - 1);
 	bomberman->setPlacedBombs(bomberman->getPlacedBombs() + 1);
 }
@@ -30,14 +33,14 @@ Bomb::Bomb(int powerLevel, int x, int y, Bomberman* bomberman) : Bomb(powerLevel
 void Bomb::update(Game * game) {
 	Entity::update(game);
 
-	if (Tile* t = game->map->getTileAtCoordinates(this->getX(), this->getY())) {
-		if (!t->isBombPlaced()) {
-			t->setBombPlaced(true);
-			alertTilesOfBomb(t, game);
+	ticksToExplosion--;
+	if (!registeredDanger) {
+		registeredDanger = true;
+		if (Tile* t = game->map->getTileAtCoordinates(this->getX(), this->getY())) {
+			game->map->getDangerMap().addBomb(*game->map, getHandle(), t->getIndex(), bombPowerLevel, bombPenetration, ticksToExplosion);
 		}
 	}
-	
-	ticksToExplosion--;
+
 	if (ticksToExplosion == Constants::BOMB_EXPLOSION_EFFECT_DURATION) {
 		sprite.setEffect(Sprite::EXPLOSION, Constants::BOMB_EXPLOSION_EFFECT_DURATION);
 	}
@@ -46,6 +49,30 @@ void Bomb::update(Game * game) {
 	} 
 }
 
+void Bomb::saveState(EntityState& state, WorldSnapshot& snapshot) const {
+	Entity::saveState(state, snapshot);
+	state.type = EntityState::BOMB;
+	state.bomb.bomberman = bomberman;
+	state.bomb.bombPowerLevel = bombPowerLevel;
+	state.bomb.bombPenetration = bombPenetration;
+	state.bomb.ticksToExplosion = ticksToExplosion;
+	state.bomb.registeredDanger = registeredDanger;
+	state.bomb.isExploding = isExploding;
+}
+
+void Bomb::restoreState(const EntityState& state, const WorldSnapshot& snapshot, Game* game) {
+	Entity::restoreState(state, snapshot, game);
+	bomberman = state.bomb.bomberman;
+	bombPowerLevel = state.bomb.bombPowerLevel;
+	bombPenetration = state.bomb.bombPenetration;
+	ticksToExplosion = state.bomb.ticksToExplosion;
+	registeredDanger = state.bomb.registeredDanger;
+	isExploding = state.bomb.isExploding;
+	if (ticksToExplosion <= Constants::BOMB_EXPLOSION_EFFECT_DURATION) {
+		sprite.setEffect(Sprite::EXPLOSION, Constants::BOMB_EXPLOSION_EFFECT_DURATION);
+	}
+}
+
 void Bomb::explode(Game * game) {
 	if (!isExploding) {
 		isExploding = true;
@@ -53,14 +80,15 @@ void Bomb::explode(Game * game) {
 		//Create explosion
 		Tile* tile = game->map->getTileAtCoordinates(this->getCenterX(), this->getCenterY());
 		if (tile) {
-			if (Game::debug) std::cout << game->getTickString() << "Bomb exploded at " << tile->getX() << "," << tile->getY() << std::endl;
+			if (game->isDebug()) game->getLog() << game->getTickString() << "Bomb exploded at " << tile->getX() << "," << tile->getY() << std::endl;
+			game->map->getDangerMap().explodeBomb(*game->map, getHandle(), tile->getIndex(), bombPowerLevel, bombPenetration);
 			createExplosion(tile, game);
 		} else {
-			if (Game::debug) std::cout << game->getTickString() << "Bomb exploded outside the map!" << std::endl;
+			if (game->isDebug()) game->getLog() << game->getTickString() << "Bomb exploded outside the map!" << std::endl;
 		}
 
 		//Handle bomb count of the bomberman is one is assigned
-		if (bomberman) {
+		if (Bomberman* bomberman = getBomberman(game)) {
 			bomberman->setAvailableBombs(bomberman->getAvailableBombs() + 1);
 			bomberman->setPlacedBombs(bomberman->getPlacedBombs() - 1);
 		}
@@ -69,8 +97,13 @@ void Bomb::explode(Game * game) {
 }
 
 void Bomb::createExplosion(Tile* tile, Game * game) const {
+	//Explosion particles are only visual and are skipped in headless games
+	const bool createParticles = !game->isHeadless();
+
 	tile->destroyWall(game);
-	game->entityManager->addEntity((new ExplosionParticle(tile->getX(), tile->getY(), ExplosionParticle::CENTER, this->bombPowerLevel))->centerInRect(*tile->getRect()));
+	if (createParticles) {
+		game->particleSystem->addExplosion(*tile->getRect(), ParticleSystem::CENTER);
+	}
 
 	//Create bomb beams in all 4 major directions from the base tile.
 	//The beams stop at the first indestructible wall or when they destroy as many walls as their penetration value.
@@ -95,41 +128,41 @@ void Bomb::createExplosion(Tile* tile, Game * game) const {
 				//If a wall was truly destroyed, increment the wallsDestroyed counter
 				if (tileToDestroy->destroyWall(game)) {
 					wallsDestroyed++;
-					if (this->bomberman) this->bomberman->addScore(Constants::WALL_DESTROY_SCORE);
+					if (Bomberman* bomberman = getBomberman(game)) bomberman->addScore(Constants::WALL_DESTROY_SCORE);
 				}
 
 				Tile* nextTile = nullptr;
-				ExplosionParticle::Direction explosionDirection = ExplosionParticle::CENTER;
-				ExplosionParticle::Direction explosionDirectionEnd = ExplosionParticle::CENTER;
+				ParticleSystem::ExplosionDirection explosionDirection = ParticleSystem::CENTER;
+				ParticleSystem::ExplosionDirection explosionDirectionEnd = ParticleSystem::CENTER;
 				switch (dir) {
 					case 0:
 						nextTile = game->map->getTileAbove(tileToDestroy);
-						explosionDirection = ExplosionParticle::UP;
-						explosionDirectionEnd = ExplosionParticle::UP_END;
+						explosionDirection = ParticleSystem::UP;
+						explosionDirectionEnd = ParticleSystem::UP_END;
 						break;
 					case 1:
 						nextTile = game->map->getTileLeft(tileToDestroy);
-						explosionDirection = ExplosionParticle::LEFT;
-						explosionDirectionEnd = ExplosionParticle::LEFT_END;
+						explosionDirection = ParticleSystem::LEFT;
+						explosionDirectionEnd = ParticleSystem::LEFT_END;
 						break;
 					case 2:
 						nextTile = game->map->getTileBelow(tileToDestroy);
-						explosionDirection = ExplosionParticle::DOWN;
-						explosionDirectionEnd = ExplosionParticle::DOWN_END;
+						explosionDirection = ParticleSystem::DOWN;
+						explosionDirectionEnd = ParticleSystem::DOWN_END;
 						break;
 					case 3:
 						nextTile = game->map->getTileRight(tileToDestroy);
-						explosionDirection = ExplosionParticle::RIGHT;
-						explosionDirectionEnd = ExplosionParticle::RIGHT_END;
+						explosionDirection = ParticleSystem::RIGHT;
+						explosionDirectionEnd = ParticleSystem::RIGHT_END;
 						break;
 				}
 
-				if (nextTile) {
+				if (nextTile && createParticles) {
 					//Create explosion entity for this tile
 					if (nextTile && !nextTile->isIndestructible() && i != bombPowerLevel - 1 && wallsDestroyed < bombPenetration) {
-						game->entityManager->addEntity((new ExplosionParticle(tileToDestroy->getX(), tileToDestroy->getY(), explosionDirection, this->bombPowerLevel))->centerInRect(*tileToDestroy->getRect()));
+						game->particleSystem->addExplosion(*tileToDestroy->getRect(), explosionDirection);
 					} else {
-						game->entityManager->addEntity((new ExplosionParticle(tileToDestroy->getX(), tileToDestroy->getY(), explosionDirectionEnd, this->bombPowerLevel))->centerInRect(*tileToDestroy->getRect()));
+						game->particleSystem->addExplosion(*tileToDestroy->getRect(), explosionDirectionEnd);
 					}
 				}
 			} else {
@@ -166,59 +199,26 @@ void Bomb::createExplosion(Tile* tile, Game * game) const {
 
 	//Trigger any bombs that the horizontal collider hits
 	std::vector<std::shared_ptr<Entity>> collidingEntities;
-	if (Collision::checkCollision(*horizontalCollider.getRect(), nullptr, &collidingEntities, this, game)) {
+	if (Collision::checkEntityCollision(*horizontalCollider.getRect(), nullptr, &collidingEntities, this, game)) {
 		for (auto& entity : collidingEntities) {
-			Entity* entityPtr = entity.get();
-			if (Bomb* bomb = dynamic_cast<Bomb*>(entityPtr)) {
-				bomb->explode(game);
+			if (entity->getKind() == BOMB) {
+				static_cast<Bomb*>(entity.get())->explode(game);
 			}
 		}
 	}
 
 	//Trigger any bombs that the vertical collider hits
-	if (Collision::checkCollision(*verticalCollider.getRect(), nullptr, &collidingEntities, this, game)) {
+	if (Collision::checkEntityCollision(*verticalCollider.getRect(), nullptr, &collidingEntities, this, game)) {
 		for (auto& entity : collidingEntities) {
-			Entity* entityPtr = entity.get();
-			if (Bomb* bomb = dynamic_cast<Bomb*>(entityPtr)) {
-				bomb->explode(game);
+			if (entity->getKind() == BOMB) {
+				static_cast<Bomb*>(entity.get())->explode(game);
 			}
 		}
 	}
 	
 }
 
-void Bomb::alertTilesOfBomb(Tile* tile, Game* game) const {
-	//Create bomb beams in all 4 major directions from the base tile.
-	//The beams stop at the first indestructible wall or when they destroy as many walls as their penetration value.
-	Tile* nextTile = tile;
-	nextTile->setTicksToExplosion(this->ticksToExplosion + Constants::EXPLOSION_DURATION);
-	for (int dir = 0; dir < 4; dir++) {
-		int wallsDestroyed = 0;
-		for (int i = 0; i < bombPowerLevel; i++) {
-			switch (dir) {
-				case 0:
-					nextTile = game->map->getTileAbove(nextTile); break;
-				case 1:
-					nextTile = game->map->getTileLeft(nextTile); break;
-				case 2:
-					nextTile = game->map->getTileBelow(nextTile); break;
-				case 3:
-					nextTile = game->map->getTileRight(nextTile); break;
-			}
-			if (nextTile && !nextTile->isIndestructible() && wallsDestroyed < bombPenetration) {
-				//If a wall was truly destroyed, increment the wallsDestroyed counter
-				if (!nextTile->isIndestructible() && nextTile->isWall()) {
-					wallsDestroyed++;
-				}
-
-				//Alert tile of bomb
-				if (nextTile->getTicksToExplosion() < 1) {
-					nextTile->setTicksToExplosion(this->ticksToExplosion + Constants::EXPLOSION_DURATION);
-				}
-			} else {
-				break;
-			}
-		}
-		nextTile = tile;
-	}
+Bomberman* Bomb::getBomberman(Game* game) const {
+	//A bomberman that died since is no longer managed, its bombs still count for it
+	return game->getBomberman(bomberman);
 }
@@ -12,8 +12,8 @@ class Tile;
  */
 class Bomb : public Entity {
 protected:
-	/*! The bomberman entity that placed this bomb, can be null. */
-	Bomberman* bomberman = nullptr;
+	/*! Handle of the bomberman entity that placed this bomb, can be null. */
+	EntityHandle bomberman;
 
 	/*! Number of tiles the bomb explosion spans. */
 	int bombPowerLevel;
@@ -21,12 +21,12 @@ protected:
 	/*! Number of walls the bomb explosion beam destroys before stopping. */
 	int bombPenetration = Constants::DEFAULT_BOMB_PENETRATION;
 
-	/*!
-	 * A utility value used by the AI. Specifies when an explosion is about to happen so the AI can
-	 * evaluate how dangerous this tile is.
-	 */
+	/*! Number of ticks remaining until the bomb explodes. */
 	int ticksToExplosion = Constants::BOMB_EXPLOSION_TIME;
 
+	/*! Whether the bomb was registered in the danger map of the game map. */
+	bool registeredDanger = false;
+
 	/*!
 	 * Flag indicating that the bombs explode method was already triggered.
 	 * Prevents issues when bombs trigger other bombs.
@@ -38,25 +38,24 @@ public:
 
 	void update(Game* game) override;
 
+	void saveState(EntityState& state, WorldSnapshot& snapshot) const override;
+	void restoreState(const EntityState& state, const WorldSnapshot& snapshot, Game* game) override;
+
 	/*!
 	 * Triggers the explosion of the bomb.
 	 */
 	void explode(Game* game);
 protected:
 	/*!
-	 * Creates the explosion beams. Including particle effects and damage colliders.
-	 * 
-	 * \param tile The center of the explosion.
-	 * \param game Game pointer.
+	 * Returns the bomberman that placed this bomb, also when it died since, nullptr if the bomb has no bomberman.
 	 */
-	void createExplosion(Tile* tile, Game* game) const;
+	Bomberman* getBomberman(Game* game) const;
 
 	/*!
-	 * A utility method for the AI that calculates where the bomb explosion will reach
-	 * and sets the ticksToExplosion values for the tiles.
+	 * Creates the explosion beams. Including particle effects and damage colliders.
 	 * 
 	 * \param tile The center of the explosion.
 	 * \param game Game pointer.
 	 */
-	void alertTilesOfBomb(Tile* tile, Game* game) const;
+	void createExplosion(Tile* tile, Game* game) const;
 };
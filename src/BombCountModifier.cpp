@@ -4,6 +4,7 @@
 #include "Bomberman.h"
 #include "TextureManager.h"
 #include "EntityManager.h"
+#include "WorldSnapshot.h"
 
 #include <iostream>
 #include <string>
@@ -17,13 +18,24 @@ amountOfBombsToAdd(amountOfBombsToAdd) {
 	}	
 }
 
+void BombCountModifier::saveState(EntityState& state, WorldSnapshot& snapshot) const {
+	PowerUp::saveState(state, snapshot);
+	state.type = EntityState::BOMB_COUNT_MODIFIER;
+	state.collectable.amount = amountOfBombsToAdd;
+}
+
+void BombCountModifier::restoreState(const EntityState& state, const WorldSnapshot& snapshot, Game* game) {
+	PowerUp::restoreState(state, snapshot, game);
+	amountOfBombsToAdd = state.collectable.amount;
+}
+
 void BombCountModifier::applyEffects(Game * game) {
 	for (auto& entity: potentialCollectors) {
-		Entity* entityPtr = entity.get();
-		if (Bomberman* bomberman = dynamic_cast<Bomberman*>(entityPtr)) {
+		if (entity->isBomberman()) {
+			Bomberman* bomberman = static_cast<Bomberman*>(entity.get());
 			bomberman->changeBombCount(amountOfBombsToAdd);
 			changeScore(bomberman, (this->amountOfBombsToAdd < 1));
-			if (Game::debug) std::cout << game->getTickString() << "Bomberman picked up BombCountModifier (" << amountOfBombsToAdd << ")" << std::endl;
+			if (game->isDebug()) game->getLog() << game->getTickString() << "Bomberman picked up BombCountModifier (" << amountOfBombsToAdd << ")" << std::endl;
 			game->entityManager->removeEntity(this);
 		}
 	}
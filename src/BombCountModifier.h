@@ -18,7 +18,10 @@ public:
 	 * Can be negative to act as a negative power-up
 	 */
 	BombCountModifier(int amountOfBombsToAdd, int initialX, int initialY);
-	
+
+	void saveState(EntityState& state, WorldSnapshot& snapshot) const override;
+	void restoreState(const EntityState& state, const WorldSnapshot& snapshot, Game* game) override;
+
 protected:
 	void applyEffects(Game* game) override;
 
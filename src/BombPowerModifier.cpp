@@ -5,6 +5,7 @@
 #include "TextureManager.h"
 #include "PowerUp.h"
 #include "Game.h"
+#include "WorldSnapshot.h"
 
 #include <iostream>
 #include <string>
@@ -18,13 +19,24 @@ BombPowerModifier::BombPowerModifier(int powerLevelIncrease, int initialX, int i
 	}
 }
 
+void BombPowerModifier::saveState(EntityState& state, WorldSnapshot& snapshot) const {
+	PowerUp::saveState(state, snapshot);
+	state.type = EntityState::BOMB_POWER_MODIFIER;
+	state.collectable.amount = powerLevelIncrease;
+}
+
+void BombPowerModifier::restoreState(const EntityState& state, const WorldSnapshot& snapshot, Game* game) {
+	PowerUp::restoreState(state, snapshot, game);
+	powerLevelIncrease = state.collectable.amount;
+}
+
 void BombPowerModifier::applyEffects(Game * game) {
 	for (auto& entity : potentialCollectors) {
-		Entity* entityPtr = entity.get();
-		if (Bomberman* bomberman = dynamic_cast<Bomberman*>(entityPtr)) {
+		if (entity->isBomberman()) {
+			Bomberman* bomberman = static_cast<Bomberman*>(entity.get());
 			bomberman->setBombPowerLevel(bomberman->getBombPowerLevel() + powerLevelIncrease);
 			changeScore(bomberman, (this->powerLevelIncrease < 1));
-			if (Game::debug) std::cout << game->getTickString() << "Bomberman picked up BombPowerModifier (" << powerLevelIncrease << ")" << std::endl;
+			if (game->isDebug()) game->getLog() << game->getTickString() << "Bomberman picked up BombPowerModifier (" << powerLevelIncrease << ")" << std::endl;
 			game->entityManager->removeEntity(this);
 		}
 	}
@@ -17,6 +17,9 @@ public:
 	 */
 	BombPowerModifier(int powerLevelIncrease, int initialX, int initialY);
 
+	void saveState(EntityState& state, WorldSnapshot& snapshot) const override;
+	void restoreState(const EntityState& state, const WorldSnapshot& snapshot, Game* game) override;
+
 protected:
 	void applyEffects(Game* game) override;
 };
@@ -6,14 +6,15 @@
 #include "Utils.h"
 #include "Game.h"
 #include "Map.h"
+#include "WorldSnapshot.h"
 
 Bomberman::Bomberman(int initialX, int initialY)
 : Movable(TextureManager::bombermanTexture, initialX, initialY, Constants::BOMBERMAN_SIZE, Constants::BOMBERMAN_SIZE) {
 	 
 }
 
-void Bomberman::render(SDL_Renderer * renderer) {
-	Movable::render(renderer);
+void Bomberman::render(SpriteBatch& batch) {
+	Movable::render(batch);
 }
 
 void Bomberman::update(Game* game) {
@@ -54,6 +55,38 @@ void Bomberman::update(Game* game) {
 	}
 }
 
+void Bomberman::saveState(EntityState& state, WorldSnapshot& snapshot) const {
+	Movable::saveState(state, snapshot);
+	state.bomberman.health = health;
+	state.bomberman.maxHealth = maxHealth;
+	state.bomberman.score = score;
+	state.bomberman.concussion = concussion;
+	state.bomberman.concussionTick = concussionTick;
+	state.bomberman.concussionDuration = concussionDuration;
+	state.bomberman.placeDownBombOnUpdate = placeDownBombOnUpdate;
+	state.bomberman.maxBombs = maxBombs;
+	state.bomberman.availableBombs = availableBombs;
+	state.bomberman.placedBombs = placedBombs;
+	state.bomberman.bombPowerLevel = bombPowerLevel;
+	state.bomberman.currentTile = currentTile ? currentTile->getIndex() : -1;
+}
+
+void Bomberman::restoreState(const EntityState& state, const WorldSnapshot& snapshot, Game* game) {
+	Movable::restoreState(state, snapshot, game);
+	health = state.bomberman.health;
+	maxHealth = state.bomberman.maxHealth;
+	score = state.bomberman.score;
+	concussion = state.bomberman.concussion;
+	concussionTick = state.bomberman.concussionTick;
+	concussionDuration = state.bomberman.concussionDuration;
+	placeDownBombOnUpdate = state.bomberman.placeDownBombOnUpdate;
+	maxBombs = state.bomberman.maxBombs;
+	availableBombs = state.bomberman.availableBombs;
+	placedBombs = state.bomberman.placedBombs;
+	bombPowerLevel = state.bomberman.bombPowerLevel;
+	currentTile = state.bomberman.currentTile >= 0 ? &game->map->getTiles()[state.bomberman.currentTile] : nullptr;
+}
+
 int Bomberman::getAvailableBombs() const {
 	return availableBombs;
 }
@@ -98,7 +131,7 @@ void Bomberman::setBombPowerLevel(int powerLevel) {
 
 void Bomberman::kill(Game * game) {
 	//TODO: death animation
-	if (Game::debug) std::cout << game->getTickString() << "Bomberman killed" << std::endl;
+	if (game->isDebug()) game->getLog() << game->getTickString() << "Bomberman killed" << std::endl;
 	currentTile = game->map->getTileAtCoordinates(this->getCenterX(), this->getCenterY());
 	if (currentTile) currentTile->setBombermanPresent(false);
 	game->entityManager->removeEntity(this);
@@ -149,7 +182,7 @@ bool Bomberman::placeDownBomb(Game * game) {
 	bool bombPlaced = false;
 	Tile* tile = game->map->getTileAtCoordinates(this->getCenterX(), this->getCenterY());
 	if (tile && this->collidingEntities.empty()) {
-		if (Game::debug) std::cout << game->getTickString() << "Bomberman placed down bomb at " << tile->getX() << "," << tile->getY() << std::endl;
+		if (game->isDebug()) game->getLog() << game->getTickString() << "Bomberman placed down bomb at " << tile->getX() << "," << tile->getY() << std::endl;
 		game->entityManager->addEntity(new Bomb(this->bombPowerLevel, tile->getX(), tile->getY(), this));
 		bombPlaced = true;
 	}
@@ -44,9 +44,12 @@ public:
 	 */
 	Bomberman(int initialX, int initialY);
 
-	void render(SDL_Renderer* renderer) override;
+	void render(SpriteBatch& batch) override;
 	void update(Game* game) override;
 
+	void saveState(EntityState& state, WorldSnapshot& snapshot) const override;
+	void restoreState(const EntityState& state, const WorldSnapshot& snapshot, Game* game) override;
+
 	/*!
 	 * Returns ther amount of bombs the bomberman can place at the moment.
 	 */
@@ -1,15 +1,16 @@
 #include "Collectable.h"
 
 #include "Collision.h"
+#include "WorldSnapshot.h"
 
 #include <iostream>
 
-Collectable::Collectable(SDL_Texture * texture, int initialX, int initialY, int width, int height)
+Collectable::Collectable(const TextureRegion& texture, int initialX, int initialY, int width, int height)
 : Entity(texture, initialX, initialY, width, height) {
 	this->setCollidable(false);
 }
 
-Collectable::Collectable(SDL_Texture* texture, int lifetime, int initialX, int initialY, int width, int height)
+Collectable::Collectable(const TextureRegion& texture, int lifetime, int initialX, int initialY, int width, int height)
 : Entity(texture, initialX, initialY, width, height),
 vanishEnabled(true),
 ticksToVanish(lifetime) {
@@ -21,13 +22,25 @@ void Collectable::update(Game * game) {
 		ticksToVanish--;
 		if (ticksToVanish <= 0) {
 			game->entityManager->removeEntity(this);
-			if (Game::debug) std::cout << game->getTickString() << "Collectable vanished" << std::endl;
+			if (game->isDebug()) game->getLog() << game->getTickString() << "Collectable vanished" << std::endl;
 			return;
 		}
 	}
 
 	Entity::update(game);
-	if (Collision::checkCollision(position, nullptr, &potentialCollectors, this, game)) {
+	if (Collision::checkEntityCollision(position, nullptr, &potentialCollectors, this, game)) {
 		applyEffects(game);
 	}
 }
+
+void Collectable::saveState(EntityState& state, WorldSnapshot& snapshot) const {
+	Entity::saveState(state, snapshot);
+	state.collectable.vanishEnabled = vanishEnabled;
+	state.collectable.ticksToVanish = ticksToVanish;
+}
+
+void Collectable::restoreState(const EntityState& state, const WorldSnapshot& snapshot, Game* game) {
+	Entity::restoreState(state, snapshot, game);
+	vanishEnabled = state.collectable.vanishEnabled;
+	ticksToVanish = state.collectable.ticksToVanish;
+}
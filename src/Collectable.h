@@ -24,7 +24,7 @@ public:
 	/*!
 	 * Create the collectable at specified coordinates.
 	 */
-	Collectable(SDL_Texture* texture, int initialX, int initialY, int width, int height);
+	Collectable(const TextureRegion& texture, int initialX, int initialY, int width, int height);
 
 	/*!
 	 * Create the collectable at specified coordinates.
@@ -32,10 +32,13 @@ public:
 	 * 
 	 * \param lifetime Ticks before vanishing.
 	 */
-	Collectable(SDL_Texture* texture, int lifetime, int initialX, int initialY, int width, int height);
+	Collectable(const TextureRegion& texture, int lifetime, int initialX, int initialY, int width, int height);
 
 
 	void update(Game* game) override;
+
+	void saveState(EntityState& state, WorldSnapshot& snapshot) const override;
+	void restoreState(const EntityState& state, const WorldSnapshot& snapshot, Game* game) override;
 protected:
 	/*!
 	 * Method called upon collision with another entity. The potentialCollectors vector contains the
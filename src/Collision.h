@@ -4,17 +4,22 @@
 
 #include "Game.h"
 #include "EntityManager.h"
+#include "Map.h"
+#include "Profiler.h"
 
 #include <vector>
 #include <algorithm>
 
 /*!
  * Class containing static methods for resolving collision between entities.
+ * Collision with walls is resolved directly from the map tile grid,
+ * collision with other (dynamic) entities goes through the entity manager spatial grid.
  */
 class Collision {
 public:
 	/*!
-	 * Checks whether the specified rectangle intersects any other entities.
+	 * Checks whether the specified rectangle intersects any walls or other entities.
+	 * Colliding walls are listed first in the result, followed by colliding entities.
 	 *
 	 * \param newPosition The collision rectangle
 	 * \param entitiesToIgnore A pointer to a list of entities that should be ignored in the collision detection.
@@ -27,26 +32,118 @@ public:
 	 * that is to be ignored like the entitiesToIgnore without creating a singleton vector.
 	 * Can be a nullptr if called from outside of an entity.
 	 *
-	 * \param game Game object used to access the entity manager.
+	 * \param game Game object used to access the map and the entity manager.
 	 * \return true if a collision was detected
 	 */
 	static bool checkCollision(const SDL_Rect& newPosition, std::vector<std::shared_ptr<Entity>>* entitiesToIgnore, std::vector<std::shared_ptr<Entity>>* collidingEntitiesResult, const Entity* callingEntity, Game* game) {
+		ProfileScope scope(game->getProfiler(), Profiler::COLLISION);
+		if (collidingEntitiesResult) collidingEntitiesResult->clear();
+		const bool wallCollision = findWallCollisions(newPosition, entitiesToIgnore, collidingEntitiesResult, game);
+		if (wallCollision && !collidingEntitiesResult) {
+			return true; //Stop on the first detected collision
+		}
+		const bool entityCollision = findEntityCollisions(newPosition, entitiesToIgnore, collidingEntitiesResult, callingEntity, game);
+		return wallCollision || entityCollision;
+	}
+
+	/*!
+	 * Checks whether the specified rectangle intersects any walls of the map.
+	 * Only the tiles overlapped by the rectangle are tested.
+	 *
+	 * \param newPosition The collision rectangle
+	 * \param entitiesToIgnore A pointer to a list of entities that should be ignored, can be a nullptr.
+	 * \param collidingWallsResult A pointer to a list that gets cleared and filled with colliding wall tiles.
+	 *	Can be a nullptr. In that case the calculation will stop on the first detected collision.
+	 * \param game Game object used to access the map.
+	 * \return true if a collision was detected
+	 */
+	static bool checkWallCollision(const SDL_Rect& newPosition, std::vector<std::shared_ptr<Entity>>* entitiesToIgnore, std::vector<std::shared_ptr<Entity>>* collidingWallsResult, Game* game) {
+		ProfileScope scope(game->getProfiler(), Profiler::COLLISION);
+		if (collidingWallsResult) collidingWallsResult->clear();
+		return findWallCollisions(newPosition, entitiesToIgnore, collidingWallsResult, game);
+	}
+
+	/*!
+	 * Checks whether the specified rectangle intersects any entities other than map tiles.
+	 *
+	 * \param newPosition The collision rectangle
+	 * \param entitiesToIgnore A pointer to a list of entities that should be ignored, can be a nullptr.
+	 * \param collidingEntitiesResult A pointer to a list that gets cleared and filled with colliding entities.
+	 *	Can be a nullptr. In that case the calculation will stop on the first detected collision.
+	 * \param callingEntity The entity calling this method that is to be ignored, can be a nullptr.
+	 * \param game Game object used to access the entity manager.
+	 * \return true if a collision was detected
+	 */
+	static bool checkEntityCollision(const SDL_Rect& newPosition, std::vector<std::shared_ptr<Entity>>* entitiesToIgnore, std::vector<std::shared_ptr<Entity>>* collidingEntitiesResult, const Entity* callingEntity, Game* game) {
+		ProfileScope scope(game->getProfiler(), Profiler::COLLISION);
 		if (collidingEntitiesResult) collidingEntitiesResult->clear();
+		return findEntityCollisions(newPosition, entitiesToIgnore, collidingEntitiesResult, callingEntity, game);
+	}
+private:
+	static bool isIgnored(const Entity* entity, std::vector<std::shared_ptr<Entity>>* entitiesToIgnore) {
+		return entitiesToIgnore && std::find_if(entitiesToIgnore->begin(), entitiesToIgnore->end(), [entity](const std::shared_ptr<Entity>& ignored) { return ignored.get() == entity; }) != entitiesToIgnore->end();
+	}
+
+	/*!
+	 * Integer division rounding towards negative infinity, used to find tiles of rects partially outside of the map.
+	 */
+	static int floorDivide(int value, int divisor) {
+		return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+	}
+
+	/*!
+	 * Appends colliding walls to the result without clearing it.
+	 */
+	static bool findWallCollisions(const SDL_Rect& newPosition, std::vector<std::shared_ptr<Entity>>* entitiesToIgnore, std::vector<std::shared_ptr<Entity>>* collidingWallsResult, Game* game) {
+		if (newPosition.w <= 0 || newPosition.h <= 0) {
+			return false;
+		}
+		Map* map = game->map;
+
+		//Range of tiles overlapped by the rectangle, tiles cover the map without gaps so any tile in the range intersects it
+		const int minX = std::max(floorDivide(newPosition.x, map->tileSize), 0);
+		const int minY = std::max(floorDivide(newPosition.y, map->tileSize), 0);
+		const int maxX = std::min(floorDivide(newPosition.x + newPosition.w - 1, map->tileSize), map->mapTileWidth - 1);
+		const int maxY = std::min(floorDivide(newPosition.y + newPosition.h - 1, map->tileSize), map->mapTileHeight - 1);
+
 		bool collisionDetected = false;
-		for (auto& entity : game->entityManager->getEntities()) {
-			if (entity.get() != callingEntity && entity->isCollidable()) {
-				if (!entitiesToIgnore || (entitiesToIgnore && std::find(entitiesToIgnore->begin(), entitiesToIgnore->end(), entity) == entitiesToIgnore->end())) {
-					if (SDL_HasIntersection(&newPosition, entity->getRect())) {
-						collisionDetected = true;
-						if (collidingEntitiesResult) {
-							collidingEntitiesResult->push_back(entity);
-						} else {
-							break;
-						}
+		for (int y = minY; y <= maxY; y++) {
+			const int rowStart = y * map->mapTileWidth;
+			for (int index = rowStart + minX; index <= rowStart + maxX; index++) {
+				if (!map->isWall(index)) {
+					continue;
+				}
+				Tile* tile = &map->getTiles()[index];
+				if (!isIgnored(tile, entitiesToIgnore)) {
+					collisionDetected = true;
+					if (collidingWallsResult) {
+						//Tiles are owned by the map, the result holds a non-owning pointer to them
+						collidingWallsResult->push_back(std::shared_ptr<Entity>(std::shared_ptr<Entity>(), tile));
+					} else {
+						return true;
 					}
 				}
 			}
 		}
 		return collisionDetected;
 	}
+
+	/*!
+	 * Appends colliding entities to the result without clearing it.
+	 */
+	static bool findEntityCollisions(const SDL_Rect& newPosition, std::vector<std::shared_ptr<Entity>>* entitiesToIgnore, std::vector<std::shared_ptr<Entity>>* collidingEntitiesResult, const Entity* callingEntity, Game* game) {
+		bool collisionDetected = false;
+		//Only entities in the spatial grid cells overlapping the rect are tested
+		for (Entity* entity : game->entityManager->getEntitiesInRect(newPosition)) {
+			if (entity != callingEntity && entity->isCollidable() && !isIgnored(entity, entitiesToIgnore)) {
+				collisionDetected = true;
+				if (collidingEntitiesResult) {
+					collidingEntitiesResult->push_back(entity->shared_from_this());
+				} else {
+					break;
+				}
+			}
+		}
+		return collisionDetected;
+	}
 };
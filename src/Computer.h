@@ -1,11 +1,16 @@
 #pragma once
 
-#include <random>
+#include <string>
+#include <vector>
 
 #include "Bomberman.h"
+#include "MapOverlay.h"
+#include "Pathfinder.h"
+#include "Random.h"
 
 class Map;
 class Tile;
+class DistanceField;
 
 /*!
  * A bomberman controlled by the computer.
@@ -36,27 +41,70 @@ private:
 	Tile* bombPlacedTile = nullptr;
 	Tile* bombExitTile = nullptr;
 	
-	std::mt19937 randomNumberGenerator;
+	/*! Random stream of this AI, see Random::COMPUTER_STREAMS. */
+	Random randomNumberGenerator;
+
+	/*! Overlay of the game map the AI simulates its bombs in, reused between logic updates. */
+	MapOverlay planningOverlay;
+
+	/*! Pathfinding with search buffers reused between searches. */
+	Pathfinder pathfinder;
+
+	/*!
+	 * Actions decided by planUpdate() that update() applies.
+	 */
+	struct Plan {
+		/*! Tick the plan was made on, 0 if no plan was made yet. */
+		unsigned int tick = 0;
+		/*! Whether to place down a bomb. */
+		bool placeBomb = false;
+		/*! Tile to move towards, nullptr to stand still. */
+		Tile* nextTile = nullptr;
+		/*! Planned path shown with Game::isShowAI(). */
+		std::vector<Tile*> path;
+		/*! AI messages printed with Game::isShowAI(), deferred so that planning does not write to the console. */
+		std::string log;
+	};
+	Plan plan;
 public:
 	/*!
 	 * Creates a computer controlled bomberman with specified coordinates.
 	 * \param index Number used to distinguish between other computers
+	 * \param random Random number generator of the AI.
+	 */
+	Computer(int id, int initialX, int initialY, const Random& random);
+
+	/*!
+	 * Decides what the AI does this tick. Updates only the state of this AI and reads the rest of the game,
+	 * so the plans of all computers can be made in parallel before the entities are updated.
+	 * The actions are applied by the following update().
+	 *
+	 * \see Game::planComputers()
 	 */
-	Computer(int id, int initialX, int initialY);
+	void planUpdate(Game* game);
 
+	/*!
+	 * Applies the actions of the plan made this tick, if no plan was made yet it is made first.
+	 */
 	void update(Game* game) override;
 
+	/*!
+	 * Stores the state of the AI. The plan is not stored, it is made again on the next tick.
+	 */
+	void saveState(EntityState& state, WorldSnapshot& snapshot) const override;
+	void restoreState(const EntityState& state, const WorldSnapshot& snapshot, Game* game) override;
+
 	int getID() const;
 private:
 	/*!
-	 * Simulates effects of a bomb explosion on tiles of a map.
+	 * Simulates effects of a bomb explosion on tiles of a map overlay.
 	 * 
 	 * \param explosionTile Explosion centre tile.
 	 * \param bombPowerLevel Power level of the bomb.
 	 * \param bombPenetrationLevel Penetration level of the bomb.
-	 * \param map The map.
+	 * \param overlay The map overlay the explosion is written to.
 	 */
-	void simulateBombExplosionOnMap(Tile* explosionTile, int bombPowerLevel, int bombPenetrationLevel, Map* map);
+	void simulateBombExplosionOnMap(Tile* explosionTile, int bombPowerLevel, int bombPenetrationLevel, MapOverlay& overlay);
 
 	/*!
 	 * Returns a list of tiles around the player that are within "beams" projected
@@ -68,67 +116,22 @@ private:
 	std::vector<Tile*> getTilesAroundPlayer(Tile* playerTile, Map* map);
 
 	/*!
-	 * Searches for the first tile to which a path can be found in the given list.
-	 * An empty path is returned when no path can be found to any of the tiles in the list.
-	 * This operation is very performance demanding if there are potential targets.
+	 * Searches for the closest tile in the given list to which a path can be found.
+	 * All potential targets are resolved by a single distance field lookup instead of a search for each of them.
 	 * 
-	 * \param startingTile Tile of the path start.
-	 * \param listOfTiles List of potential path targets.
+	 * \param distanceField Distance field computed from the path start.
+	 * \param listOfTiles List of potential path targets, the targets do not need to be walkable.
 	 * \param map The map.
-	 * \return The path as returned from Astar pathfinding.
-	 * \see getPathAstar()
+	 * \param path Filled with the path, the first element is the target and the last element is the first tile of the path.
+	 * \return true if any of the tiles is reachable, false otherwise.
+	 * \see DistanceField::findClosest()
 	 */
-	std::vector<Tile*> findAccessibleTile(Tile* startingTile, std::vector<Tile*>& listOfTiles, Map& map);
+	bool findAccessibleTile(const DistanceField& distanceField, const std::vector<Tile*>& listOfTiles, Map& map, std::vector<Tile*>& path) const;
 
 	/*!
-	 * Searches for the first tile to which a path can be found in the given list.
-	 * An empty path is returned when no path can be found to any of the tiles in the list.
-	 * This operation is very performance demanding if there are potential targets.
-	 * Some targets may get skipped based on a random chance.
-	 *
-	 * \param startingTile Tile of the path start.
-	 * \param listOfTiles List of potential path targets.
-	 * \param map The map.
-	 * \param introduceRandomness
-	 * \param skipChance
-	 * \param minRandomnessCount
-	 * \return The path as returned from Astar pathfinding.
-	 * \see getPathAstar()
-	 */
-	std::vector<Tile*> findAccessibleTile(Tile* startingTile, std::vector<Tile*>& listOfTiles, Map& map, bool introduceRandomness, int skipChance, int minRandomnessCount);
-
-	/*!
-	 * Returns the shortest path between the two tiles using the A* pathfinding algorithm.
-	 *
-	 * \param start Start tile
-	 * \param finish Target tile
-	 * \return A list containing a sequence of tiles forming the path. The last element of the list is the first tile of the path.
-	 * \see Map::getWalkableNeighbourTiles()
-	 */
-	std::vector<Tile*> getPathAstar(Tile* start, Tile* finish, Map& map);
-
-	
-	/*!
-	 * Returns the first tile that fulfills a condition found by a breadth first search algorithm
-	 * starting from the starting tile. The algorithm searches walkable tiles.
-	 *
-	 * The condition can be specified like so:
-	 * \code{.cpp}
-	 	bool operator() (Tile* tile, Map* map) const {
-			if (tile->isWall()) {
-				return true;
-			}
-			return false;
-		}
-	 * \endcode 
-	 * \param startingTile The start tile of the search.
-	 * \param map The map.
-	 * \param targetTileCondition A condition that the tile needs to fulfill.
-	 * \return The found tile or a nullptr if nothing was found.
-	 * \see Map::getWalkableNeighbourTiles()
+	 * Adds a message to the plan log if Game::isShowAI() is enabled.
 	 */
-	template<typename ConditionFunction>
-	Tile* tileBreadthFirstSearch(Tile* startingTile, Map* map, ConditionFunction targetTileCondition);
+	void logDecision(Game* game, const char* message);
 
 	/*!
 	 * Moves the AI towards the center of a tile.
@@ -15,8 +15,33 @@ public:
 	static const int PLAYER_MAX_COUNT = 2;
 	static const int PLAYER_OR_COMPUTER_MAX_COUNT = 4;
 	
+	/*! Number of game ticks simulated per second of real time (at time scale 1). */
 	static const int TARGET_FPS = 60;
-	static const int SLOWMO_FPS = 6;
+	/*! Time scale applied in slow motion. */
+	static constexpr double SLOWMO_TIME_SCALE = 0.1;
+	/*!
+	 * Maximum number of ticks simulated between two rendered frames.
+	 * When the simulation falls further behind the remaining time is dropped instead of being caught up on.
+	 */
+	static const int MAX_TICKS_PER_FRAME = 5;
+	static const int HEADLESS_MAX_TICKS = 10 * 60 * SECOND;
+	/*! Number of ticks the game goes back by when rewound with F6. */
+	static const int REWIND_TICKS = SECOND;
+
+	/*! Ticks of player inputs kept by a network session, the ticks in flight between the peers have to fit. */
+	static const int LOCKSTEP_INPUT_WINDOW = 128;
+	/*! Ticks between sampling a local input and simulating it in a network match, hides the network latency. */
+	static const int LOCKSTEP_INPUT_DELAY = 2;
+	static const int LOCKSTEP_MAX_INPUT_DELAY = 30;
+	/*! Ticks a network match is simulated ahead of the inputs of the peer with predicted inputs, 0 disables rollback. */
+	static const int ROLLBACK_TICKS = 8;
+	static const int ROLLBACK_MAX_TICKS = 30;
+	/*! Interval of repeating the unacknowledged inputs while no new inputs are sent. */
+	static const int LOCKSTEP_RESEND_INTERVAL_MS = 50;
+	/*! Time without packets from the peer after which the match ends. */
+	static const int LOCKSTEP_TIMEOUT_MS = 10000;
+	/*! Longest time an ended headless network match keeps answering the peer, which may still miss the last inputs. */
+	static const int LOCKSTEP_LINGER_MS = 1000;
 	static const int DEFAULT_MOVABLE_SPEED = 2;
 
 	static const int WALL_DESTROY_SCORE = 10;
@@ -2,36 +2,50 @@
 
 #include "Bomberman.h"
 #include "Game.h"
+#include "EntityManager.h"
+#include "WorldSnapshot.h"
 
 #include <iostream>
 
 DamageCollider::DamageCollider(int lifetime, int x, int y, int width, int height)
-: Collectable(NULL, lifetime, x, y, width, height) {
-	
+: Collectable(TextureRegion(), lifetime, x, y, width, height) {
+	kind = DAMAGE_COLLIDER;
 }
 
-Bomberman* DamageCollider::getOwner() const {
+void DamageCollider::saveState(EntityState& state, WorldSnapshot& snapshot) const {
+	Collectable::saveState(state, snapshot);
+	state.type = EntityState::DAMAGE_COLLIDER;
+	state.collectable.owner = owner;
+}
+
+void DamageCollider::restoreState(const EntityState& state, const WorldSnapshot& snapshot, Game* game) {
+	Collectable::restoreState(state, snapshot, game);
+	owner = state.collectable.owner;
+}
+
+EntityHandle DamageCollider::getOwner() const {
 	return owner;
 }
 
-void DamageCollider::setOwner(Bomberman* owner) {
+void DamageCollider::setOwner(EntityHandle owner) {
 	this->owner = owner;
 }
 
 void DamageCollider::applyEffects(Game* game) {
+	Bomberman* ownerBomberman = game->getBomberman(owner);
 	for (auto& entity : potentialCollectors) {
-		Entity* entityPtr = entity.get();
-		if (Bomberman* bomberman = dynamic_cast<Bomberman*>(entityPtr)) {
+		if (entity->isBomberman()) {
+			Bomberman* bomberman = static_cast<Bomberman*>(entity.get());
 			if (bomberman->damage()) {
 				//Add or remove score of the owner
-				if (owner) {
-					if (owner == bomberman) {
-						owner->addScore(Constants::BOMBERMAN_SELF_DAMAGE_SCORE);
+				if (ownerBomberman) {
+					if (ownerBomberman == bomberman) {
+						ownerBomberman->addScore(Constants::BOMBERMAN_SELF_DAMAGE_SCORE);
 					} else {
-						owner->addScore(Constants::BOMBERMAN_DAMAGE_SCORE);
+						ownerBomberman->addScore(Constants::BOMBERMAN_DAMAGE_SCORE);
 					}	
 				}
-				if (Game::debug) std::cout << game->getTickString() << "Explosion damaged bomberman" << std::endl;
+				if (game->isDebug()) game->getLog() << game->getTickString() << "Explosion damaged bomberman" << std::endl;
 			}
 		}
 	}
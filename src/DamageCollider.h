@@ -8,8 +8,8 @@
  */
 class DamageCollider : public Collectable {
 protected:
-	/*! Owner of the damage entity. Used to keep track of score. */
-	Bomberman* owner = nullptr;
+	/*! Handle of the owner of the damage entity. Used to keep track of score. */
+	EntityHandle owner;
 
 public:
 	/*!
@@ -20,15 +20,18 @@ public:
 	 */
 	DamageCollider(int lifetime, int x, int y, int width, int height);
 
+	void saveState(EntityState& state, WorldSnapshot& snapshot) const override;
+	void restoreState(const EntityState& state, const WorldSnapshot& snapshot, Game* game) override;
+
 	/*!
 	 * Returns the owner of the damage entity. Used to keep track of score.
 	 */
-	Bomberman* getOwner() const;
+	EntityHandle getOwner() const;
 
 	/*!
 	 * Sets the owner of the damage entity. Used to keep track of score.
 	 */
-	void setOwner(Bomberman* owner);
+	void setOwner(EntityHandle owner);
 protected:
 	void applyEffects(Game* game) override;
 };
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include "DangerMap.h"
+
+#include "Map.h"
+#include "Constants.h"
+
+#include <algorithm>
+
+const unsigned int DangerMap::NO_HIT;
+
+void DangerMap::reset(std::size_t tileCount) {
+	bombs.clear();
+	hitTicks.assign(tileCount, NO_HIT);
+	bombPlaced.assign(tileCount, false);
+	markedTiles.clear();
+	nextExpiry = NO_HIT;
+}
+
+void DangerMap::update(const Map& map, unsigned int tick) {
+	this->tick = tick;
+	if (tick < nextExpiry) {
+		return;
+	}
+
+	//Explosions that ended no longer endanger their tiles.
+	//Bombs that were removed without exploding expire the same way.
+	bombs.erase(std::remove_if(bombs.begin(), bombs.end(), [tick](const BombRecord& record) {
+		return record.resolvedTick + Constants::EXPLOSION_DURATION <= tick;
+	}), bombs.end());
+	rebuild(map);
+}
+
+void DangerMap::addBomb(const Map& map, EntityHandle bomb, int index, int power, int penetration, int ticksToExplosion) {
+	BombRecord record;
+	record.bomb = bomb;
+	record.index = index;
+	record.power = power;
+	record.penetration = penetration;
+	record.explosionTick = tick + std::max(ticksToExplosion, 0);
+	record.resolvedTick = record.explosionTick;
+	bombs.push_back(record);
+	rebuild(map);
+}
+
+void DangerMap::explodeBomb(const Map& map, EntityHandle bomb, int index, int power, int penetration) {
+	//Exploded records have a null handle, a bomb that is not managed never matches them
+	auto it = std::find_if(bombs.begin(), bombs.end(), [bomb](const BombRecord& record) {
+		return !bomb.isNull() && record.bomb == bomb;
+	});
+	if (it == bombs.end()) {
+		addBomb(map, bomb, index, power, penetration, 0);
+		it = bombs.end() - 1;
+	}
+
+	//The reach is fixed now, the explosion is about to destroy the walls that stop it
+	it->bomb = EntityHandle();
+	it->explosionTick = tick;
+	computeReach(map, *it);
+	rebuild(map);
+}
+
+int DangerMap::getTicksToExplosion(int index) const {
+	if (hitTicks[index] == NO_HIT) {
+		return 0;
+	}
+	const unsigned int endTick = hitTicks[index] + Constants::EXPLOSION_DURATION;
+	return endTick > tick ? static_cast<int>(endTick - tick) : 0;
+}
+
+void DangerMap::computeReach(const Map& map, BombRecord& record) const {
+	static const int columnSteps[4] = { 0, -1, 0, 1 };
+	static const int rowSteps[4] = { -1, 0, 1, 0 };
+
+	record.reach.clear();
+	record.reach.push_back(record.index);
+	for (int dir = 0; dir < 4; dir++) {
+		int column = record.index % map.mapTileWidth;
+		int row = record.index / map.mapTileWidth;
+		int wallsDestroyed = 0;
+		for (int i = 0; i < record.power; i++) {
+			column += columnSteps[dir];
+			row += rowSteps[dir];
+			if (column < 0 || row < 0 || column >= map.mapTileWidth || row >= map.mapTileHeight) {
+				break;
+			}
+			const int index = row * map.mapTileWidth + column;
+			if (map.isIndestructible(index) || wallsDestroyed >= record.penetration) {
+				break;
+			}
+			if (map.isWall(index)) {
+				wallsDestroyed++;
+			}
+			record.reach.push_back(index);
+		}
+	}
+}
+
+void DangerMap::rebuild(const Map& map) {
+	//Walls might have been destroyed since the bombs that did not explode yet were placed
+	for (auto& record : bombs) {
+		if (!record.bomb.isNull()) {
+			computeReach(map, record);
+		}
+		record.resolvedTick = record.explosionTick;
+	}
+
+	//Resolve chain reactions in the order the bombs explode.
+	//A bomb in the reach of a bomb that did not explode yet explodes on the same tick as that bomb at the latest.
+	//Bombs that already exploded do not trigger any more bombs.
+	std::vector<unsigned char> resolved(bombs.size(), false);
+	for (size_t step = 0; step < bombs.size(); step++) {
+		size_t next = bombs.size();
+		for (size_t i = 0; i < bombs.size(); i++) {
+			if (!resolved[i] && (next == bombs.size() || bombs[i].resolvedTick < bombs[next].resolvedTick)) {
+				next = i;
+			}
+		}
+		resolved[next] = true;
+		const BombRecord& trigger = bombs[next];
+		if (trigger.bomb.isNull()) {
+			continue;
+		}
+		for (size_t i = 0; i < bombs.size(); i++) {
+			BombRecord& record = bombs[i];
+			if (!resolved[i] && !record.bomb.isNull() && record.resolvedTick > trigger.resolvedTick
+				&& std::find(trigger.reach.begin(), trigger.reach.end(), record.index) != trigger.reach.end()) {
+				record.resolvedTick = trigger.resolvedTick;
+			}
+		}
+	}
+
+	for (const int index : markedTiles) {
+		hitTicks[index] = NO_HIT;
+		bombPlaced[index] = false;
+	}
+	markedTiles.clear();
+
+	nextExpiry = NO_HIT;
+	for (const auto& record : bombs) {
+		for (const int index : record.reach) {
+			if (hitTicks[index] == NO_HIT) {
+				markedTiles.push_back(index);
+			}
+			hitTicks[index] = std::min(hitTicks[index], record.resolvedTick);
+		}
+		bombPlaced[record.index] = true;
+		nextExpiry = std::min(nextExpiry, record.resolvedTick + Constants::EXPLOSION_DURATION);
+	}
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "EntityHandle.h"
+
+#include <vector>
+#include <limits>
+#include <cstddef>
+
+class Map;
+
+/*!
+ * Tracks which tiles are going to be hit by bomb explosions and when.
+ *
+ * The map keeps one danger map that every AI reads, so a safety query is a single array lookup.
+ * The per tile values are only recomputed when a bomb is placed, when a bomb explodes
+ * and when an explosion ends, not on every tick.
+ *
+ * A bomb that lies in the reach of another bomb explodes together with it, such chains are resolved
+ * so that the tiles of the chained bomb are marked with the earlier explosion tick.
+ */
+class DangerMap {
+public:
+	/*! Hit tick of a tile that no bomb reaches. */
+	static const unsigned int NO_HIT = std::numeric_limits<unsigned int>::max();
+private:
+	struct BombRecord {
+		/*! Handle of the bomb entity, used only to identify the record, a null handle once the bomb exploded. */
+		EntityHandle bomb;
+		/*! Tile index of the bomb. */
+		int index;
+		int power;
+		int penetration;
+		/*! Tick on which the bomb explodes on its own or on which it actually exploded. */
+		unsigned int explosionTick;
+		/*! Tick on which the bomb explodes when chain reactions are taken into account. */
+		unsigned int resolvedTick;
+		/*! Tile indexes the explosion reaches, fixed once the bomb exploded. */
+		std::vector<int> reach;
+	};
+
+	std::vector<BombRecord> bombs;
+
+	/*! The earliest tick on which the tile is hit by an explosion. */
+	std::vector<unsigned int> hitTicks;
+	std::vector<unsigned char> bombPlaced;
+
+	/*! Tiles that were marked by the last rebuild, only these need to be cleared by the next one. */
+	std::vector<int> markedTiles;
+
+	/*! The current game tick. */
+	unsigned int tick = 0;
+
+	/*! Tick on which the earliest explosion ends and the danger map needs to be rebuilt. */
+	unsigned int nextExpiry = NO_HIT;
+public:
+	/*!
+	 * Discards all bombs and resizes the danger map for a map with the number of tiles.
+	 */
+	void reset(std::size_t tileCount);
+
+	/*!
+	 * Advances the danger map to the tick, removes explosions that ended.
+	 * Called once per tick by the map before entities are updated.
+	 */
+	void update(const Map& map, unsigned int tick);
+
+	/*!
+	 * Registers a placed bomb.
+	 *
+	 * \param map The map, the reach of the bomb is calculated from its walls.
+	 * \param bomb Handle of the bomb entity, identifies the bomb in explodeBomb().
+	 * \param index Tile index of the bomb.
+	 * \param power Number of tiles the explosion spans.
+	 * \param penetration Number of walls the explosion beams destroy before stopping.
+	 * \param ticksToExplosion Number of ticks until the bomb explodes.
+	 */
+	void addBomb(const Map& map, EntityHandle bomb, int index, int power, int penetration, int ticksToExplosion);
+
+	/*!
+	 * Marks the bomb as exploded on the current tick.
+	 * Needs to be called before the explosion destroys any walls so that the recorded reach matches the explosion.
+	 * A bomb that was not registered yet is registered as exploded.
+	 *
+	 * \see addBomb()
+	 */
+	void explodeBomb(const Map& map, EntityHandle bomb, int index, int power, int penetration);
+
+	/*! Whether a bomb lies on the tile or its explosion did not end yet. */
+	bool isBombPlaced(int index) const { return bombPlaced[index] != 0; }
+
+	/*! The earliest tick on which the tile is hit by an explosion or NO_HIT. */
+	unsigned int getHitTick(int index) const { return hitTicks[index]; }
+
+	/*!
+	 * Number of ticks until the earliest explosion reaching the tile ends, 0 if no bomb reaches the tile.
+	 */
+	int getTicksToExplosion(int index) const;
+private:
+	/*!
+	 * Calculates the tiles the explosion of the bomb reaches with the current walls of the map.
+	 * Mirrors the beam rules of Bomb::createExplosion().
+	 */
+	void computeReach(const Map& map, BombRecord& record) const;
+
+	/*!
+	 * Resolves chain reactions and recomputes the per tile values.
+	 */
+	void rebuild(const Map& map);
+};
@@ -0,0 +1,83 @@
+#include "DistanceField.h"
+
+#include "Map.h"
+
+void DistanceField::compute(Map& map, const Tile* source, unsigned int tick) {
+	const size_t tileCount = map.getTiles().size();
+	distances.assign(tileCount, -1);
+	expanded.assign(tileCount, false);
+	queue.clear();
+	this->tick = tick;
+	sourceIndex = source ? source->getIndex() : -1;
+	if (!source) {
+		return;
+	}
+
+	distances[sourceIndex] = 0;
+	expanded[sourceIndex] = true;
+	queue.push_back(sourceIndex);
+
+	//The queue is never popped from the front, the head index marks the next tile to process
+	for (size_t head = 0; head < queue.size(); head++) {
+		const int current = queue[head];
+		map.getExistingNeighbourTiles(&map.getTiles()[current], true, neighbours);
+		for (Tile* neighbour : neighbours) {
+			const int index = neighbour->getIndex();
+			if (distances[index] < 0) {
+				distances[index] = distances[current] + 1;
+				if (map.isWalkable(index)) {
+					expanded[index] = true;
+					queue.push_back(index);
+				}
+			}
+		}
+	}
+}
+
+bool DistanceField::isComputed(const Tile* source, unsigned int tick) const {
+	return !distances.empty() && this->tick == tick && sourceIndex == (source ? source->getIndex() : -1);
+}
+
+void DistanceField::invalidate() {
+	distances.clear();
+}
+
+int DistanceField::getDistance(const Tile* tile) const {
+	return distances[tile->getIndex()];
+}
+
+Tile* DistanceField::findClosest(const std::vector<Tile*>& targets) const {
+	Tile* closest = nullptr;
+	int closestDistance = -1;
+	for (Tile* target : targets) {
+		const int distance = getDistance(target);
+		if (distance > 0 && (!closest || distance < closestDistance)) {
+			closest = target;
+			closestDistance = distance;
+		}
+	}
+	return closest;
+}
+
+bool DistanceField::getPath(Map& map, const Tile* target, bool allowUnwalkableTarget, std::vector<Tile*>& path) const {
+	path.clear();
+	int current = target->getIndex();
+	if (distances[current] < 0 || (!allowUnwalkableTarget && !expanded[current])) {
+		return false;
+	}
+
+	//Descend the field from the target towards the source
+	std::vector<Tile>& tiles = map.getTiles();
+	while (distances[current] > 0) {
+		path.push_back(&tiles[current]);
+		const Tile* tile = &tiles[current];
+		const Tile* candidates[4] = {map.getTileAbove(tile), map.getTileLeft(tile), map.getTileBelow(tile), map.getTileRight(tile)};
+		for (const Tile* candidate : candidates) {
+			if (candidate && expanded[candidate->getIndex()] && distances[candidate->getIndex()] == distances[current] - 1) {
+				current = candidate->getIndex();
+				break;
+			}
+		}
+	}
+	return true;
+}
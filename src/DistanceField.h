@@ -0,0 +1,73 @@
+#pragma once
+
+#include <vector>
+
+class Map;
+class Tile;
+
+/*!
+ * Walking distances from a source tile to every tile of the map, computed with a single breadth first search.
+ *
+ * The search continues only through walkable tiles, but unwalkable tiles next to a reached walkable tile
+ * get a distance as well. This way a wall, a dangerous tile or a tile with a bomberman can be a target
+ * without toggling its walkability on the map.
+ */
+class DistanceField {
+private:
+	/*! Source tile index, -1 if the field was not computed. */
+	int sourceIndex = -1;
+
+	/*! Tick the field was computed on. */
+	unsigned int tick = 0;
+
+	/*! Number of steps from the source tile, -1 for unreachable tiles. */
+	std::vector<int> distances;
+
+	/*! Whether the search continued through the tile, only such tiles can be on a path. */
+	std::vector<unsigned char> expanded;
+
+	std::vector<int> queue;
+	std::vector<Tile*> neighbours;
+public:
+	/*!
+	 * Computes the distances from the source tile.
+	 * \param map The map.
+	 * \param source Source tile, can be a nullptr in which case no tile is reachable.
+	 * \param tick The current game tick.
+	 */
+	void compute(Map& map, const Tile* source, unsigned int tick);
+
+	/*! Whether the field was computed from the source tile on the tick. */
+	bool isComputed(const Tile* source, unsigned int tick) const;
+
+	/*!
+	 * Marks the field as not computed, used when the game tick goes back and the tick number no longer identifies the map state.
+	 */
+	void invalidate();
+
+	/*!
+	 * Returns the number of steps from the source tile to the tile or -1 if the tile cannot be reached.
+	 */
+	int getDistance(const Tile* tile) const;
+
+	/*!
+	 * Returns the reachable tile closest to the source.
+	 * Tiles with the same distance are decided by the order in the list. The source tile itself is skipped.
+	 *
+	 * \param targets List of potential targets.
+	 * \return The closest reachable target or a nullptr if none can be reached.
+	 */
+	Tile* findClosest(const std::vector<Tile*>& targets) const;
+
+	/*!
+	 * Traces the shortest path from the source to the target tile.
+	 *
+	 * \param map The map the field was computed on.
+	 * \param target Target tile.
+	 * \param allowUnwalkableTarget Whether a target that the search did not continue through can end the path.
+	 * \param path Filled with the path. The first element is the target, the last element is the first tile of the path.
+	 *	The path is empty if the target is the source.
+	 * \return true if a path exists
+	 */
+	bool getPath(Map& map, const Tile* target, bool allowUnwalkableTarget, std::vector<Tile*>& path) const;
+};
@@ -2,8 +2,9 @@
 
 #include "Game.h"
 #include "Utils.h"
+#include "WorldSnapshot.h"
 
-Entity::Entity(SDL_Texture* texture, int initialX, int initialY, int width, int height)
+Entity::Entity(const TextureRegion& texture, int initialX, int initialY, int width, int height)
 : sprite(Sprite(texture)),
 position(Utils::createSDLRect(initialX, initialY, width, height)) {
 	
@@ -15,8 +16,34 @@ void Entity::update(Game* game) {
 	sprite.update(game->getTick());
 }
 
-void Entity::render(SDL_Renderer* renderer) {
-	sprite.render(position, renderer);
+void Entity::render(SpriteBatch& batch) {
+	sprite.render(position, batch);
+}
+
+void Entity::saveState(EntityState& state, WorldSnapshot& snapshot) const {
+	state.handle = handle;
+	state.position = position;
+	state.collidable = collidable;
+	state.foregroundRender = foregroundRender;
+	state.toBeRemoved = toBeRemoved;
+	state.renderingExternal = renderingExternal;
+}
+
+void Entity::restoreState(const EntityState& state, const WorldSnapshot& snapshot, Game* game) {
+	position = state.position;
+	updateSpatialGrid();
+	collidable = state.collidable;
+	foregroundRender = state.foregroundRender;
+	toBeRemoved = state.toBeRemoved;
+	renderingExternal = state.renderingExternal;
+}
+
+Entity::Kind Entity::getKind() const {
+	return kind;
+}
+
+bool Entity::isBomberman() const {
+	return kind == PLAYER || kind == COMPUTER;
 }
 
 bool Entity::isCollidable() const {
@@ -27,7 +54,7 @@ void Entity::setCollidable(bool collidable) {
 	this->collidable = collidable;
 }
 
-void Entity::setTexture(SDL_Texture * texture) {
+void Entity::setTexture(const TextureRegion& texture) {
 	this->sprite.setTexture(texture);
 }
 
@@ -61,34 +88,41 @@ const SDL_Rect* Entity::getRect() const {
 
 void Entity::setX(int x) {
 	position.x = x;
+	updateSpatialGrid();
 }
 
 void Entity::setY(int y) {
 	position.y = y;
+	updateSpatialGrid();
 }
 
 void Entity::setWidth(int w) {
-	position.w = w; 
+	position.w = w;
+	updateSpatialGrid();
 }
 
 void Entity::setHeight(int h) {
 	position.h = h;
+	updateSpatialGrid();
 }
 
 Entity* Entity::centerInRect(SDL_Rect rect) {
 	Utils::centerRectInRect(&position, rect);
+	updateSpatialGrid();
 	return this;
 }
 
 void Entity::placeAt(int x, int y) {
 	position.x = x;
 	position.y = y;
+	updateSpatialGrid();
 }
 
 
 void Entity::move(int x, int y) {
 	position.x = position.x + x;
 	position.y = position.y + y;
+	updateSpatialGrid();
 }
 
 bool Entity::isRenderingExternal() const {
@@ -113,4 +147,14 @@ bool Entity::isToBeRemoved() const {
 
 void Entity::setToBeRemoved(bool toBeRemoved) {
 	this->toBeRemoved = toBeRemoved;
+}
+
+EntityHandle Entity::getHandle() const {
+	return handle;
+}
+
+void Entity::updateSpatialGrid() {
+	if (spatialGridEntry.grid) {
+		spatialGridEntry.grid->update(this);
+	}
 }
\ No newline at end of file
@@ -1,13 +1,37 @@
 #pragma once
 
 #include "Sprite.h"
+#include "SpatialGrid.h"
+#include "EntityHandle.h"
+
+#include <memory>
 
 class Game;
+struct EntityState;
+struct WorldSnapshot;
 
 /*!
  *	Entity resembles an object in the game world.
  */
-class Entity {
+class Entity : public std::enable_shared_from_this<Entity> {
+	friend class SpatialGrid;
+	friend class EntityManager;
+public:
+	/*!
+	 * Kind of an entity. The entity manager keeps a list of the entities of every kind,
+	 * so that game logic can iterate and identify entities of a kind without casting.
+	 * The kind is set by the constructor and does not change afterwards.
+	 */
+	enum Kind {
+		GENERIC, PLAYER, COMPUTER, BOMB, POWER_UP, DAMAGE_COLLIDER,
+		KIND_COUNT
+	};
+private:
+	/*! Registration in the spatial grid of the entity manager. The grid is updated whenever the position changes. */
+	SpatialGridEntry spatialGridEntry;
+
+	/*! Handle of the entity in its entity manager, a null handle if the entity is not managed. */
+	EntityHandle handle;
 protected:
 	/*! The texture representation of the entity. */
 	Sprite sprite;
@@ -15,6 +39,9 @@ protected:
 	/*!	Rectangle representing the position of the entity in the game world. */
 	SDL_Rect position;
 	
+	/*! Kind of the entity, set by the constructors of the entity types. */
+	Kind kind = GENERIC;
+
 	/*! Whether collision aware entities can collide with this entity. */
 	bool collidable = true;
 
@@ -40,7 +67,7 @@ public:
 	 * \param width
 	 * \param height
 	 */
-	Entity(SDL_Texture* texture, int initialX, int initialY, int width, int height);
+	Entity(const TextureRegion& texture, int initialX, int initialY, int width, int height);
 
 	virtual ~Entity();
 
@@ -49,7 +76,35 @@ public:
 	 * \param game Game object used to access information about the game world.
 	 */
 	virtual void update(Game* game);
-	virtual void render(SDL_Renderer* renderer);
+
+	/*!
+	 * Adds the entity sprite to a sprite batch.
+	 */
+	virtual void render(SpriteBatch& batch);
+
+	/*!
+	 * Stores the simulation state of the entity. Every entity type that can be managed overrides this method,
+	 * stores the state of its class after calling the base class and sets the state type.
+	 *
+	 * \param state The state of this entity.
+	 * \param snapshot The snapshot the state belongs to, holds the variable length parts of the state.
+	 */
+	virtual void saveState(EntityState& state, WorldSnapshot& snapshot) const;
+
+	/*!
+	 * Restores the simulation state stored by saveState().
+	 * Called once all entities of the snapshot are back in the entity manager, so that handles can be resolved.
+	 *
+	 * \param state The state of this entity.
+	 * \param snapshot The snapshot the state belongs to.
+	 * \param game The game being restored.
+	 */
+	virtual void restoreState(const EntityState& state, const WorldSnapshot& snapshot, Game* game);
+
+	Kind getKind() const;
+
+	/*! Whether the entity is a Bomberman, a player or a computer. */
+	bool isBomberman() const;
 
 	/*! Whether collision aware entities can collide with this entity. */
 	bool isCollidable() const;
@@ -58,7 +113,7 @@ public:
 	/*!
 	 * Replaces the current texture of the entity.
 	 */
-	void setTexture(SDL_Texture* texture);
+	void setTexture(const TextureRegion& texture);
 
 	/*! Returns the top-left corner X coordinate. */
 	int getX() const;
@@ -119,4 +174,14 @@ public:
 
 	/*! Sets whether this entity should be removed from its manager. */
 	void setToBeRemoved(bool toBeRemoved);
+
+	/*!
+	 * Returns the handle of the entity in its entity manager, a null handle if the entity is not managed.
+	 */
+	EntityHandle getHandle() const;
+private:
+	/*!
+	 * Informs the spatial grid the entity is registered in about a position change.
+	 */
+	void updateSpatialGrid();
 };
\ No newline at end of file
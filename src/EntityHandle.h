@@ -0,0 +1,29 @@
+#pragma once
+
+/*!
+ * A weak reference to an entity registered in an EntityManager.
+ *
+ * A handle is a slot of the manager and the generation of the slot at the time the entity was added.
+ * The generation changes when the entity is removed, so a handle of a removed entity never resolves,
+ * not even after its slot is reused by another entity.
+ * \see EntityManager::getEntity()
+ */
+struct EntityHandle {
+	/*! Slot of the entity in its manager. */
+	unsigned int slot = 0;
+	/*! Generation of the slot, 0 for a null handle. */
+	unsigned int generation = 0;
+
+	/*! Whether the handle does not refer to any entity. */
+	bool isNull() const {
+		return generation == 0;
+	}
+
+	bool operator==(const EntityHandle& other) const {
+		return slot == other.slot && generation == other.generation;
+	}
+
+	bool operator!=(const EntityHandle& other) const {
+		return !(*this == other);
+	}
+};
@@ -1,74 +1,95 @@
 #include "EntityManager.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "Game.h"
+#include "Constants.h"
+#include "Profiler.h"
+#include "WorldSnapshot.h"
+
+EntityManager::EntityManager(int areaWidth, int areaHeight)
+: spatialGrid(areaWidth, areaHeight, Constants::TILE_SIZE) {
+	
+}
+
+EntityManager::~EntityManager() {
+	//Entities can outlive the manager (players are also held by the game), unregister them from the grid
+	for (auto& entity : entities) {
+		unregisterEntity(entity.get());
+	}
+	for (auto& entity : entitiesToAdd) {
+		unregisterEntity(entity.get());
+	}
+}
 
 void EntityManager::updateEntities(Game* game) {
-	//While iterating through entities, vector modifications can occur
-	//and thus an index for loop is used that updates all the entites
-	//present at the begining of this method which works properly because
-	//entities are always inserted at the end of the vector.
+	//Entities added during the updates are queued, so that only the entities present
+	//at the beginning of this method are updated here
+	updating = true;
 	const size_t size = entities.size();
-	for (unsigned int i = 0; i < size; i++) {
-		entities[i]->update(game);
+	for (size_t i = 0; i < size; i++) {
+		updateEntity(*entities[i], game);
 	}
-	
-	//Calculate the number of entities newly created during the update
-	const size_t numberOfEntitiesAdded = entities.size() - size;
+	addQueuedEntities();
 
-	/*
 	//Removing entities that might have been flagged for deletion during the updates.
-	for (auto& entity : entitiesToRemove) {
-		auto itr = std::find(entities.begin(), entities.end(), entity);
-		if (itr != entities.end()) {
-			entities.erase(itr);
-		}
-	}
-	entitiesToRemove.clear();
-	*/
+	const size_t firstNewEntity = removeFlaggedEntities(size);
 
-	//Removing entities that might have been flagged for deletion during the updates.
-	auto itr = entities.begin();
-	while (itr != entities.end()) {
-		if ((*itr)->isToBeRemoved()) {
-			itr = entities.erase(itr);
-		} else {
-			++itr;
-		}
+	//If any new entites were added during the update, update them as well now that the old entities were removed.
+	const size_t newSize = entities.size();
+	for (size_t i = firstNewEntity; i < newSize; i++) {
+		updateEntity(*entities[i], game);
 	}
+	updating = false;
 
-	//If any new entites were added during the update, update them as well now that the old entities were removed.
-	if (numberOfEntitiesAdded > 0) {
-		const size_t newSize = entities.size();
-		for (size_t i = (newSize - numberOfEntitiesAdded); i < newSize; i++) {
-			entities[i]->update(game);
-		}
-	}	
+	//Entities added by the new entities are updated on the next tick
+	addQueuedEntities();
+}
+
+void EntityManager::updateEntity(Entity& entity, Game* game) {
+	Profiler* profiler = game->getProfiler();
+	ProfileScope scope(profiler, profiler->isEnabled() ? profiler->getEntityTypeSection(entity) : 0);
+	entity.update(game);
 }
 
-void EntityManager::renderEntities(SDL_Renderer * renderer) const {
+void EntityManager::renderEntities(SpriteBatch& batch, bool drawWireframes) const {
 	//Render background
 	for (auto& entity : entities) {
 		if (!entity->isRenderingExternal() && !entity->isForegroundRender()) {
-			renderEntity(entity, renderer);
+			entity->render(batch);
 		}
 	}
 	//Render foreground
 	for (auto& entity : entities) {
 		if (!entity->isRenderingExternal() && entity->isForegroundRender()) {
-			renderEntity(entity, renderer);
+			entity->render(batch);
+		}
+	}
+	batch.flush();
+
+	//Wireframes are drawn over all sprites
+	if (drawWireframes) {
+		for (auto& entity : entities) {
+			if (!entity->isRenderingExternal()) {
+				SDL_RenderDrawRect(batch.getRenderer(), entity->getRect());
+			}
 		}
 	}
 }
 
 void EntityManager::addEntity(Entity * entity) {
-	const auto newEntityPtr = std::shared_ptr<Entity>(entity);
-	entities.push_back(newEntityPtr);	//Add the entity to the global entity list
+	addEntity(std::shared_ptr<Entity>(entity));
 }
 
 void EntityManager::addEntity(const std::shared_ptr<Entity>& entity) {
-	entities.push_back(entity); //Add the entity to the global entity list
+	registerEntity(entity.get());
+	if (updating) {
+		entitiesToAdd.push_back(entity);
+	} else {
+		entities.push_back(entity);	//Add the entity to the global entity list
+		entitiesOfKind[entity->getKind()].push_back(entity.get());
+	}
 }
 
 void EntityManager::removeEntity(const std::shared_ptr<Entity>& entity) {
@@ -83,9 +104,125 @@ const std::vector<std::shared_ptr<Entity>>& EntityManager::getEntities() const {
 	return entities;
 }
 
-void EntityManager::renderEntity(const std::shared_ptr<Entity>& entity, SDL_Renderer* renderer) const {
-	entity->render(renderer);
-	if (Game::drawWireframes) {
-		SDL_RenderDrawRect(renderer, entity->getRect());
+const std::vector<Entity*>& EntityManager::getEntitiesInRect(const SDL_Rect& rect) {
+	spatialGrid.query(rect, queryResult);
+	return queryResult;
+}
+
+const std::vector<Entity*>& EntityManager::getEntitiesOfKind(Entity::Kind kind) const {
+	return entitiesOfKind[kind];
+}
+
+Entity* EntityManager::getEntity(EntityHandle handle) const {
+	if (handle.isNull() || handle.slot >= slots.size()) {
+		return nullptr;
+	}
+	const Slot& slot = slots[handle.slot];
+	return slot.generation == handle.generation ? slot.entity : nullptr;
+}
+
+void EntityManager::saveState(WorldSnapshot& snapshot) const {
+	snapshot.slotGenerations.resize(slots.size());
+	for (size_t i = 0; i < slots.size(); i++) {
+		snapshot.slotGenerations[i] = slots[i].generation;
+	}
+	snapshot.freeSlots = freeSlots;
+}
+
+void EntityManager::restoreState(const WorldSnapshot& snapshot) {
+	//The slots are overwritten below, so the entities are taken out of the grid without freeing their slots
+	for (auto& entity : entities) {
+		spatialGrid.remove(entity.get());
+		entity->handle = EntityHandle();
+	}
+	for (auto& entity : entitiesToAdd) {
+		spatialGrid.remove(entity.get());
+		entity->handle = EntityHandle();
+	}
+	entities.clear();
+	entitiesToAdd.clear();
+	for (auto& kindEntities : entitiesOfKind) {
+		kindEntities.clear();
+	}
+
+	slots.resize(snapshot.slotGenerations.size());
+	for (size_t i = 0; i < slots.size(); i++) {
+		slots[i].entity = nullptr;
+		slots[i].generation = snapshot.slotGenerations[i];
+	}
+	freeSlots = snapshot.freeSlots;
+}
+
+void EntityManager::restoreEntity(const std::shared_ptr<Entity>& entity, EntityHandle handle) {
+	spatialGrid.insert(entity.get());
+	slots[handle.slot].entity = entity.get();
+	entity->handle = handle;
+	entities.push_back(entity);
+	entitiesOfKind[entity->getKind()].push_back(entity.get());
+}
+
+void EntityManager::addQueuedEntities() {
+	for (auto& entity : entitiesToAdd) {
+		entities.push_back(entity);
+		entitiesOfKind[entity->getKind()].push_back(entity.get());
+	}
+	entitiesToAdd.clear();
+}
+
+size_t EntityManager::removeFlaggedEntities(size_t firstNewEntity) {
+	size_t remaining = 0;
+	size_t firstRemainingNewEntity = 0;
+	for (size_t i = 0; i < entities.size(); i++) {
+		if (i == firstNewEntity) {
+			firstRemainingNewEntity = remaining;
+		}
+		if (entities[i]->isToBeRemoved()) {
+			unregisterEntity(entities[i].get());
+		} else {
+			//Swapped rather than moved so that the removed entities stay alive until the kind lists are pruned
+			if (remaining != i) {
+				std::swap(entities[remaining], entities[i]);
+			}
+			remaining++;
+		}
+	}
+	if (firstNewEntity >= entities.size()) {
+		firstRemainingNewEntity = remaining;
+	}
+	if (remaining != entities.size()) {
+		//The kind lists are pruned first, the removed entities may be destroyed when the list is resized
+		for (auto& kindEntities : entitiesOfKind) {
+			kindEntities.erase(std::remove_if(kindEntities.begin(), kindEntities.end(), [](const Entity* entity) {
+				return entity->isToBeRemoved();
+			}), kindEntities.end());
+		}
+		entities.resize(remaining);
+	}
+	return firstRemainingNewEntity;
+}
+
+void EntityManager::registerEntity(Entity* entity) {
+	spatialGrid.insert(entity);
+	unsigned int slot;
+	if (!freeSlots.empty()) {
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+	} else {
+		slot = static_cast<unsigned int>(slots.size());
+		slots.emplace_back();
+	}
+	slots[slot].entity = entity;
+	entity->handle = EntityHandle{ slot, slots[slot].generation };
+}
+
+void EntityManager::unregisterEntity(Entity* entity) {
+	spatialGrid.remove(entity);
+	Slot& slot = slots[entity->handle.slot];
+	slot.entity = nullptr;
+	//Generation 0 is reserved for null handles
+	if (++slot.generation == 0) {
+		slot.generation = 1;
 	}
+	freeSlots.push_back(entity->handle.slot);
+	entity->handle = EntityHandle();
 }
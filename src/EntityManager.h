@@ -1,22 +1,68 @@
 #pragma once
 
 #include "Entity.h"
+#include "EntityHandle.h"
+#include "SpatialGrid.h"
 
 #include "SDL.h"
 
 #include <vector>
 #include <memory>
 
+struct WorldSnapshot;
+
 /*!
  * Manages rendering and updates of game entities.
+ *
+ * Entities are updated in the order they were added. Entities added during an update are queued
+ * and entities flagged for removal are removed in a single pass at the end of the update,
+ * so removing any number of entities in a tick costs one pass over the entity list.
+ * Every managed entity has a slot giving it an EntityHandle that can be kept instead of a pointer.
+ * The entities are also listed by their kind, the lists are updated together with the main list.
  */
 class EntityManager {
 private:
-	/*! List of all entities managed by the manager. */
+	/*!
+	 * A slot of the handle table. The generation of a slot is incremented whenever its entity is removed,
+	 * free slots are reused by new entities.
+	 */
+	struct Slot {
+		Entity* entity = nullptr;
+		unsigned int generation = 1;
+	};
+
+	/*! List of all entities managed by the manager in the update order. */
 	std::vector<std::shared_ptr<Entity>> entities;
-	/*! Helper list used when removing entities from the main one. */
-	std::vector<std::shared_ptr<Entity>> entitiesToRemove;
+	/*! Entities added during an update, they are moved to the main list once the update of the present entities ends. */
+	std::vector<std::shared_ptr<Entity>> entitiesToAdd;
+
+	/*! Entities of the main list by their kind, in the same order. */
+	std::vector<Entity*> entitiesOfKind[Entity::KIND_COUNT];
+
+	std::vector<Slot> slots;
+	/*! Indices of the free slots. */
+	std::vector<unsigned int> freeSlots;
+
+	/*! Whether the manager is updating its entities, new entities are queued meanwhile. */
+	bool updating = false;
+
+	/*! Broadphase index of all managed entities used by collision queries. */
+	SpatialGrid spatialGrid;
+
+	/*! Reused result buffer of getEntitiesInRect(). */
+	std::vector<Entity*> queryResult;
 public:
+	/*!
+	 * Creates an entity manager for a game area of the specified size.
+	 * Entities are indexed in a tile sized spatial grid covering the area.
+	 *
+	 * \param areaWidth Width of the game area in game units (pixels).
+	 * \param areaHeight Height of the game area in game units (pixels).
+	 */
+	EntityManager(int areaWidth, int areaHeight);
+
+	~EntityManager();
+
 	/*!
 	 * Calls update() methods for all entities.
 	 * 
@@ -28,10 +74,12 @@ public:
 	 * Renders all entities of the entity manager that do not have external rendering enabled.
 	 * Entity manager itself only supports two render layers so far. Those being foreground and background.
 	 * Layer can be set using the Entity::setForegroundRender() method.
+	 * The sprites are drawn through the sprite batch, which is flushed before returning.
 	 *
-	 * \param renderer The renderer.
+	 * \param batch The sprite batch.
+	 * \param drawWireframes Whether to outline the entity rects over the sprites.
 	 */
-	void renderEntities(SDL_Renderer* renderer) const;
+	void renderEntities(SpriteBatch& batch, bool drawWireframes) const;
 
 	/*!
 	 * Adds the entity to the manager. The entity will be updated and rendered with manager updates and render calls.
@@ -59,11 +107,88 @@ public:
 
 	/*!
 	 * Returns a list of all entites in the manager.
+	 * Entities added during the current update are not in the list until the present entities were updated.
 	 */
 	const std::vector<std::shared_ptr<Entity>>& getEntities() const;
+
+	/*!
+	 * Returns a list of the entities of a kind in the manager, ordered the same way as in getEntities().
+	 */
+	const std::vector<Entity*>& getEntitiesOfKind(Entity::Kind kind) const;
+
+	/*!
+	 * Returns the entity of a handle.
+	 *
+	 * \param handle The entity handle.
+	 *
+	 * \return The entity, nullptr for a null handle or if the entity was removed from the manager.
+	 */
+	Entity* getEntity(EntityHandle handle) const;
+
+	/*!
+	 * Returns the entity of a handle cast to the type the entity was created as.
+	 *
+	 * \see getEntity(EntityHandle)
+	 */
+	template <class T>
+	T* getEntity(EntityHandle handle) const {
+		return static_cast<T*>(getEntity(handle));
+	}
+
+	/*!
+	 * Returns all entities whose rect intersects the given rect, ordered the same way as in getEntities().
+	 * The returned vector is reused and is only valid until the next call.
+	 *
+	 * \param rect The query rect.
+	 */
+	const std::vector<Entity*>& getEntitiesInRect(const SDL_Rect& rect);
+
+	/*!
+	 * Stores the handle table in a snapshot. The entities themselves are stored by the game.
+	 */
+	void saveState(WorldSnapshot& snapshot) const;
+
+	/*!
+	 * Removes all entities and restores the handle table from a snapshot.
+	 * The entities of the snapshot are then added back in their update order with restoreEntity().
+	 */
+	void restoreState(const WorldSnapshot& snapshot);
+
+	/*!
+	 * Adds an entity restored from a snapshot under the handle it had when the snapshot was captured.
+	 *
+	 * \param entity The entity.
+	 * \param handle The handle of the entity in the snapshot, its slot has to be free.
+	 */
+	void restoreEntity(const std::shared_ptr<Entity>& entity, EntityHandle handle);
 private:
 	/*!
-	 * Draws an entity with a renderer.
+	 * Updates an entity, the update time is measured per entity type when the profiler is enabled.
 	 */
-	void renderEntity(const std::shared_ptr<Entity>& entity, SDL_Renderer* renderer) const;
+	void updateEntity(Entity& entity, Game* game);
+
+	/*!
+	 * Moves the queued entities to the main list.
+	 */
+	void addQueuedEntities();
+
+	/*!
+	 * Removes all entities flagged for removal, keeping the order of the remaining ones.
+	 *
+	 * \param firstNewEntity Index of the first entity that was added during the current update.
+	 *
+	 * \return Index of the first remaining entity that was added during the current update.
+	 */
+	size_t removeFlaggedEntities(size_t firstNewEntity);
+
+	/*!
+	 * Registers an entity in the spatial grid and assigns it a slot.
+	 */
+	void registerEntity(Entity* entity);
+
+	/*!
+	 * Unregisters an entity from the spatial grid and frees its slot.
+	 */
+	void unregisterEntity(Entity* entity);
+
 };
\ No newline at end of file
@@ -9,12 +9,25 @@
 #include "Tile.h"
 #include "Player.h"
 #include "EntityManager.h"
+#include "ParticleSystem.h"
 #include "GameInfoBar.h"
+#include "WorkerPool.h"
+#include "Profiler.h"
+#include "SpriteBatch.h"
+#include "GlyphAtlas.h"
+#include "TextCache.h"
+#include "Replay.h"
+#include "WorldSnapshot.h"
+#include "Transport.h"
+#include "UdpTransport.h"
+#include "LockstepSession.h"
 
 #include <iostream>
 #include <sstream>
 #include <algorithm>
-#include <ctime>
+#include <chrono>
+#include <cmath>
+#include <thread>
 
 #include <SDL_image.h>
 
@@ -45,7 +58,7 @@
 //DONE: Movement speed powerup
 //DONE: Computer AI <------------
 //DONE: Highscore system <-----------
-//TODO: Add fps monitor and graph
+//DONE: Add fps monitor and graph
 //DONE: Move rendering into an offscreen buffer
 //DONE: Some basic UI elements
 //TODO: Bomberman death animation?
@@ -59,11 +72,7 @@
 //DONE: Review makefile
 //DONE: Make AI pickup powerups
 //TODO: Investigate AI behaviour where no walls are remaining, only players
-
-bool Game::debug = false;
-bool Game::drawWireframes = false;
-bool Game::slowMo = false;
-bool Game::showAI = false;
+//DONE: Headless simulation mode
 
 Game::Game() = default;
 
@@ -72,6 +81,19 @@ Game::~Game() {
 }
 
 bool Game::run(const char* configFile) {
+	if (!load(configFile)) {
+		return false;
+	}
+
+	if (headless) {
+		headlessGameloop();
+	} else {
+		gameloop();
+	}
+	return true;
+}
+
+bool Game::load(const char* configFile) {
 	if (configFile) {
 		try {
 			loadConfigFile(configFile);
@@ -81,14 +103,12 @@ bool Game::run(const char* configFile) {
 			return false;
 		}
 	} else {
-		std::cout << "Using default config" << std::endl;
+		getLog() << "Using default config" << std::endl;
 	}
 	if (!init()) {
 		std::cerr << "Failed to initialise the game!" << std::endl;
 		return false;
 	}
-	
-	gameloop();
 	return true;
 }
 
@@ -127,11 +147,12 @@ void Game::registerPlayer(char playerId, Tile* tile) {
 			}
 			entityManager->addEntity(newPlayer);
 			players.push_back(std::shared_ptr<Player>(newPlayer));
+			bombermanHandles.emplace_back(newPlayer->getHandle(), newPlayer.get());
 
 			if (playerName.empty()) {
-				std::cout << "Player " << playerId << " registered at " << tile->getX() << ":" << tile->getY() << std::endl;
+				getLog() << "Player " << playerId << " registered at " << tile->getX() << ":" << tile->getY() << std::endl;
 			} else {
-				std::cout << "Player " << playerName << "(" << playerId << ") registered at " << tile->getX() << ":" << tile->getY() << std::endl;
+				getLog() << "Player " << playerName << "(" << playerId << ") registered at " << tile->getX() << ":" << tile->getY() << std::endl;
 			}
 		} else {
 			std::ostringstream oss;
@@ -147,10 +168,12 @@ void Game::registerPlayer(char playerId, Tile* tile) {
 
 void Game::registerComputer(Tile* tile) {
 	if (computers.size() + players.size() < Constants::PLAYER_OR_COMPUTER_MAX_COUNT) {
-		auto newComputer = std::make_shared<Computer>(Computer(static_cast<int>(computers.size()) + 1, tile->getX(), tile->getY()));
+		const int id = static_cast<int>(computers.size()) + 1;
+		auto newComputer = std::make_shared<Computer>(Computer(id, tile->getX(), tile->getY(), Random(seed, Random::COMPUTER_STREAMS + id)));
 		entityManager->addEntity(newComputer);
 		computers.push_back(std::shared_ptr<Computer>(newComputer));
-		std::cout << "Computer " << newComputer->getID() << " registered at " << tile->getX() << ":" << tile->getY() << std::endl;
+		bombermanHandles.emplace_back(newComputer->getHandle(), newComputer.get());
+		getLog() << "Computer " << newComputer->getID() << " registered at " << tile->getX() << ":" << tile->getY() << std::endl;
 	} else {
 		std::ostringstream oss;
 		oss << "Too many computers in the map! There can only be a maximum of " << Constants::PLAYER_OR_COMPUTER_MAX_COUNT << " players or computers in the map." << std::endl;
@@ -158,11 +181,47 @@ void Game::registerComputer(Tile* tile) {
 	}
 }
 
+Bomberman* Game::getBomberman(EntityHandle handle) const {
+	for (auto& bombermanHandle : bombermanHandles) {
+		if (bombermanHandle.first == handle) {
+			return bombermanHandle.second;
+		}
+	}
+	return nullptr;
+}
+
 bool Game::init() {
-	std::cout << "Initialising game" << std::endl;
+	getLog() << "Initialising game" << std::endl;
+
+	//A played back match uses the seed, map and player names of the replay
+	if (!replayFile.empty()) {
+		replay = new Replay();
+		try {
+			replay->load(replayFile.c_str());
+		} catch (const std::runtime_error& error) {
+			std::cerr << "Failed to load replay file! ";
+			std::cerr << error.what() << std::endl;
+			return false;
+		}
+		getLog() << "Playing back replay " << replayFile << std::endl;
+		replaying = true;
+		seed = replay->getSeed();
+		seedSpecified = true;
+		useCustomMap = !replay->getMapFile().empty();
+		customMapFile = replay->getMapFile();
+		playerNames = replay->getPlayerNames();
+		if (!recordReplayFile.empty()) {
+			getLog() << "Replays are not recorded while playing back a replay" << std::endl;
+		}
+	}
 
-	//Initialising srand with the current time
-	srand(static_cast<unsigned int>(time(nullptr)));
+	//Seeding the random streams, the seed is printed so that the match can be reproduced
+	if (!seedSpecified) {
+		seed = Random::generateSeed();
+	}
+	getLog() << "Seed: " << seed << std::endl;
+	mapRandom.seed(seed, Random::MAP_STREAM);
+	powerUpRandom.seed(seed, Random::POWER_UP_STREAM);
 	
 	int windowWidth;
 	int windowHeight;
@@ -191,27 +250,50 @@ bool Game::init() {
 	windowWidth = gameDisplayRect.w;
 	windowHeight = gameDisplayRect.h + infoBarHeight;
 
-	//Initialise SDL
-	if (!initialiseSDL(windowTitle.c_str(), windowHorizontalPos, windowVerticalPos, windowWidth, windowHeight, windowFullscreen)) {
-		return false;
-	}
+	if (headless) {
+		//Headless games don't create a window, renderer, fonts or textures
+		getLog() << "Running headless" << std::endl;
+		isRunning = true;
+	} else {
+		//Initialise SDL
+		if (!initialiseSDL(windowTitle.c_str(), windowHorizontalPos, windowVerticalPos, windowWidth, windowHeight, windowFullscreen)) {
+			return false;
+		}
 
-	//Load font
-	if (!loadFonts()) {
-		return false;
-	}
-	
-	//Load textures
-	TextureManager::loadAllTextures(renderer);
+		//Load font
+		if (!loadFonts()) {
+			return false;
+		}
+
+		//Load textures
+		TextureManager::loadAllTextures(renderer);
 
-	//Create display buffer
-	gameDisplay = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, gameDisplayRect.w, gameDisplayRect.h);
+		//Create display buffer
+		gameDisplay = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, gameDisplayRect.w, gameDisplayRect.h);
+		spriteBatch = new SpriteBatch(renderer);
+		textCache = new TextCache(renderer);
 
-	//Create the game info bar
-	infoBar = new GameInfoBar(0, 0, gameDisplayRect.w, infoBarHeight);
+		//Create the game info bar
+		infoBar = new GameInfoBar(0, 0, gameDisplayRect.w, infoBarHeight);
+	}
 	
-	entityManager = new EntityManager();
+	entityManager = new EntityManager(gameDisplayRect.w, gameDisplayRect.h);
+	particleSystem = new ParticleSystem();
 	map = new Map();
+	workerPool = new WorkerPool(aiThreads);
+	profiler = new Profiler();
+	if (!profilerFile.empty() && profiler->openCsvFile(profilerFile)) {
+		getLog() << "Writing frame times to " << profilerFile << std::endl;
+	}
+	getLog() << "AI planning threads: " << workerPool->getThreadCount() << std::endl;
+
+	if (!replay && !recordReplayFile.empty()) {
+		replay = new Replay();
+		replay->setSeed(seed);
+		replay->setMapFile(useCustomMap ? customMapFile : "");
+		replay->setPlayerNames(playerNames);
+		getLog() << "Recording replay to " << recordReplayFile << std::endl;
+	}
 
 	//Generate map
 	if (useCustomMap) {
@@ -224,6 +306,17 @@ bool Game::init() {
 		map->generate(gameDisplayRect.w, gameDisplayRect.h, this);
 	}
 
+	if (!initLockstep()) {
+		return false;
+	}
+
+	//The history starts with the initial state of the match
+	if (snapshotHistory > 0) {
+		snapshots = new SnapshotRing(snapshotHistory);
+		captureSnapshot(snapshots->push());
+		getLog() << "Keeping snapshots of the last " << snapshotHistory << " ticks" << std::endl;
+	}
+
 	//Test code that just places bombs everywhere
 	/*for (int y = 0; y < map->mapTileHeight; y++) {
 		for (int x = 0; x < map->mapTileWidth; x++) {
@@ -249,19 +342,31 @@ bool Game::loadFonts() {
 		std::cerr << TTF_GetError() << std::endl;
 		return false;
 	}
+	fontGlyphs = new GlyphAtlas(font, renderer);
+	smallerFontGlyphs = new GlyphAtlas(smallerFont, renderer);
 	return true;
 }
 
 void Game::update() {
+	ProfileScope scope(profiler, Profiler::UPDATE);
 	if (!endOfGame) {
 		tick++;
+		updateLockstepInputs();
+		updateReplayInputs();
 
+		map->update(this);
+		planComputers();
 		entityManager->updateEntities(this);
+		//The particles were advanced when the ticks were simulated the first time
+		if (!resimulating) {
+			ProfileScope scope(profiler, Profiler::PARTICLE_UPDATE);
+			particleSystem->update();
+		}
 
 		if (debug) {
 			debugInfoTick++;
 			if (debugInfoTick >= debugInfoTickThreshold) {
-				std::cout << getTickString() << "INFO: Number of entities: " << entityManager->getEntities().size() << std::endl;
+				getLog() << getTickString() << "INFO: Number of entities: " << entityManager->getEntities().size() << std::endl;
 				debugInfoTick = 0;
 			}
 		}
@@ -327,33 +432,396 @@ void Game::update() {
 		}
 	}
 
-	if (gameEnded != endOfGame) {
+	//Captured after the end conditions were checked, so that the restored tick is not simulated again
+	if (snapshots && !gameEnded) {
+		ProfileScope scope(profiler, Profiler::SNAPSHOT);
+		captureSnapshot(snapshots->push());
+	}
+
+	finishMatch();
+
+	if (replaying && !replayFinished && (endOfGame || tick >= replay->getLength())) {
+		finishReplay();
+	}
+}
+
+void Game::finishMatch() {
+	if (matchFinished || !isEndOfGameFinal()) {
+		return;
+	}
+	matchFinished = true;
+	if (headless) {
+		return;
+	}
+	//Played back matches were counted when they were recorded, rewound matches are not counted
+	if (!replaying && !rewound) {
 		try {
 			loadHighscores(highscoreFile.c_str());
 		} catch (std::runtime_error& error) {
-			std::cout << "Cannot load old highscore file (" << error.what() << ")" << std::endl;
+			getLog() << "Cannot load old highscore file (" << error.what() << ")" << std::endl;
 		}
-		std::cout << "Generating highscore file" << std::endl;
+		getLog() << "Generating highscore file" << std::endl;
 		generateHighscoreFile(highscoreFile.c_str());
-		std::cout << "Game ended! Press ESC to quit." << std::endl;
 	}
+	getLog() << "Game ended! Press ESC to quit." << std::endl;
+}
+
+bool Game::isTickConfirmed() const {
+	return !lockstep || lockstep->isConfirmed(tick);
+}
+
+bool Game::isEndOfGameFinal() const {
+	return endOfGame && isTickConfirmed();
+}
+
+void Game::updateReplayInputs() {
+	if (!replay) {
+		return;
+	}
+	if (replaying) {
+		const std::vector<Replay::InputChange>& inputChanges = replay->getInputChanges();
+		while (replayPosition < inputChanges.size() && inputChanges[replayPosition].tick <= tick) {
+			const Replay::InputChange& change = inputChanges[replayPosition];
+			for (auto& player : players) {
+				if (player->getPlayerId() == change.playerId) {
+					player->setInput(change.input);
+				}
+			}
+			replayPosition++;
+		}
+	} else {
+		for (auto& player : players) {
+			replay->recordInput(tick, player->getPlayerId(), player->getInput());
+		}
+	}
+}
+
+bool Game::initLockstep() {
+	if (lockstepPeer.empty() && !transport) {
+		return true;
+	}
+	if (replaying) {
+		getLog() << "Network matches can't be played back from a replay, the replay is played locally" << std::endl;
+		return true;
+	}
+	if (!transport) {
+		const size_t separator = lockstepPeer.rfind(':');
+		try {
+			if (separator == std::string::npos) {
+				throw std::invalid_argument(lockstepPeer);
+			}
+			const unsigned long peerPort = std::stoul(lockstepPeer.substr(separator + 1));
+			transport.reset(new UdpTransport(static_cast<Uint16>(lockstepPort), lockstepPeer.substr(0, separator), static_cast<Uint16>(peerPort)));
+		} catch (const std::logic_error&) {
+			std::cerr << "Invalid lockstepPeer value " << lockstepPeer << ", expected host:port" << std::endl;
+			return false;
+		} catch (const std::runtime_error& error) {
+			std::cerr << "Failed to connect to the peer! ";
+			std::cerr << error.what() << std::endl;
+			return false;
+		}
+	}
+
+	//Players not controlled on this side are controlled by the peer
+	std::string localPlayers;
+	std::string remotePlayers;
+	for (auto& player : players) {
+		if (lockstepPlayers.find(player->getPlayerId()) != std::string::npos) {
+			localPlayers += player->getPlayerId();
+		} else {
+			remotePlayers += player->getPlayerId();
+		}
+	}
+	//Recorded inputs have to be final, a replay can't take back the inputs of rolled back ticks
+	if (replay && rollbackTicks > 0) {
+		getLog() << "Rollback is disabled while recording a replay" << std::endl;
+		rollbackTicks = 0;
+	}
+	//A rollback restores the state before the first mispredicted tick, which is at most rollbackTicks old
+	if (rollbackTicks > 0) {
+		snapshotHistory = std::max(snapshotHistory, rollbackTicks + 2);
+	}
+
+	const Uint32 matchTag = LockstepSession::getMatchTag(seed, useCustomMap ? customMapFile : "");
+	lockstep = new LockstepSession(std::move(transport), localPlayers, remotePlayers, lockstepInputDelay, rollbackTicks, matchTag);
+	getLog() << "Network match, local players: " << (localPlayers.empty() ? "none" : localPlayers)
+		<< ", input delay: " << lockstep->getInputDelay() << " ticks"
+		<< ", rollback: " << lockstep->getRollbackTicks() << " ticks" << std::endl;
+	return true;
+}
+
+bool Game::isNextTickReady() {
+	//An ended match keeps exchanging packets, the peer may still be waiting for the last inputs
+	if (!lockstep) {
+		return true;
+	}
+	bool ready;
+	try {
+		ready = lockstep->prepareTick(tick + 1);
+		rollback();
+	} catch (const std::runtime_error& error) {
+		std::cerr << "Network match failed! ";
+		std::cerr << error.what() << std::endl;
+		stopLockstep("Connection failed");
+		return true;
+	}
+	if (lockstep->isPeerLost()) {
+		stopLockstep("Connection lost");
+		return true;
+	}
+	//An ended match does not simulate more ticks, update() finishes it once the end is confirmed
+	return ready || endOfGame;
+}
+
+void Game::rollback() {
+	const unsigned int rollbackTick = lockstep->getRollbackTick();
+	if (rollbackTick == 0) {
+		return;
+	}
+	lockstep->clearRollbackTick();
+
+	ProfileScope scope(profiler, Profiler::ROLLBACK);
+	const WorldSnapshot* snapshot = snapshots ? snapshots->findTick(rollbackTick - 1) : nullptr;
+	if (!snapshot || snapshot->tick != rollbackTick - 1) {
+		std::ostringstream oss;
+		oss << "The state before tick " << rollbackTick << " is no longer kept, the match can't be rolled back" << std::endl;
+		throw std::runtime_error(oss.str());
+	}
+
+	//The ticks up to the present are simulated again within the frame, without repeating their messages and particles
+	const unsigned int presentTick = tick;
+	rollbackCount++;
+	resimulating = true;
+	particleSystem->setMuted(true);
+	restoreSnapshot(*snapshot);
+	snapshots->discardAfter(tick);
+	while (tick < presentTick && !endOfGame) {
+		update();
+	}
+	particleSystem->setMuted(false);
+	resimulating = false;
+}
+
+void Game::stopLockstep(const std::string& message) {
+	delete lockstep;
+	lockstep = nullptr;
+	if (!endOfGame) {
+		handleEndOfGame(message);
+	}
+}
+
+void Game::updateLockstepInputs() {
+	if (!lockstep) {
+		return;
+	}
+	for (auto& player : players) {
+		player->setInput(lockstep->getInput(tick, player->getPlayerId()));
+	}
+}
+
+void Game::finishReplay() {
+	replayFinished = true;
+	const std::vector<std::string> outcome = getMatchOutcome();
+	const std::vector<std::string>& recordedOutcome = replay->getOutcome();
+	if (outcome == recordedOutcome) {
+		getLog() << "Replay outcome matches the recording" << std::endl;
+	} else {
+		getLog() << "Replay outcome differs from the recording" << std::endl;
+		getLog() << "Recorded:" << std::endl;
+		for (auto& line : recordedOutcome) {
+			getLog() << "  " << line << std::endl;
+		}
+		getLog() << "Replayed:" << std::endl;
+		for (auto& line : outcome) {
+			getLog() << "  " << line << std::endl;
+		}
+	}
+	if (!endOfGame) {
+		handleEndOfGame("Replay ended");
+	}
+}
+
+void Game::saveReplay() const {
+	if (!replay || replaying) {
+		return;
+	}
+	replay->setLength(tick);
+	replay->setOutcome(getMatchOutcome());
+	try {
+		replay->save(recordReplayFile.c_str());
+		getLog() << "Replay saved to " << recordReplayFile << std::endl;
+	} catch (const std::runtime_error& error) {
+		std::cerr << "Failed to save replay file! ";
+		std::cerr << error.what() << std::endl;
+	}
+}
+
+void Game::captureSnapshot(WorldSnapshot& snapshot) const {
+	snapshot.clear();
+	snapshot.tick = tick;
+	snapshot.endOfGame = endOfGame;
+	snapshot.mapRandom = mapRandom;
+	snapshot.powerUpRandom = powerUpRandom;
+	map->saveState(snapshot);
+	entityManager->saveState(snapshot);
+
+	for (auto& entity : entityManager->getEntities()) {
+		snapshot.entities.emplace_back();
+		entity->saveState(snapshot.entities.back(), snapshot);
+	}
+	//Dead bombermen are no longer managed, but their health and score are still part of the match
+	for (auto& player : players) {
+		if (player->getHandle().isNull()) {
+			snapshot.entities.emplace_back();
+			player->saveState(snapshot.entities.back(), snapshot);
+		}
+	}
+	for (auto& computer : computers) {
+		if (computer->getHandle().isNull()) {
+			snapshot.entities.emplace_back();
+			computer->saveState(snapshot.entities.back(), snapshot);
+		}
+	}
+}
+
+void Game::restoreSnapshot(const WorldSnapshot& snapshot) {
+	tick = snapshot.tick;
+	endOfGame = snapshot.endOfGame;
+	if (!endOfGame) {
+		endOfGameMessage.clear();
+	}
+	mapRandom = snapshot.mapRandom;
+	powerUpRandom = snapshot.powerUpRandom;
+	map->restoreState(snapshot);
+	entityManager->restoreState(snapshot);
+
+	//Players and computers are restored in place, the other entities are created again.
+	//All entities are added back first, so that the states can resolve the handles of each other.
+	restoredEntities.clear();
+	for (const EntityState& state : snapshot.entities) {
+		std::shared_ptr<Entity> entity;
+		if (state.type == EntityState::PLAYER) {
+			for (auto& player : players) {
+				if (player->getPlayerId() == state.player.playerId) {
+					entity = player;
+				}
+			}
+		} else if (state.type == EntityState::COMPUTER) {
+			for (auto& computer : computers) {
+				if (computer->getID() == state.computer.id) {
+					entity = computer;
+				}
+			}
+		} else {
+			entity = EntityState::createEntity(state);
+		}
+		if (!state.handle.isNull()) {
+			entityManager->restoreEntity(entity, state.handle);
+		}
+		restoredEntities.push_back(entity.get());
+	}
+	for (size_t i = 0; i < restoredEntities.size(); i++) {
+		restoredEntities[i]->restoreState(snapshot.entities[i], snapshot, this);
+	}
+
+	if (!endOfGame) {
+		matchFinished = false;
+	}
+
+	//Particles are only visual, the effects of the restored ticks are not displayed again.
+	//A rollback keeps them, the simulated ticks were displayed and are simulated up to the present again.
+	if (!resimulating) {
+		particleSystem->clear();
+	}
+	for (auto& distanceField : distanceFields) {
+		distanceField.second.invalidate();
+	}
+}
+
+void Game::rewind(unsigned int ticks) {
+	if (!snapshots) {
+		return;
+	}
+	if (replay && !replaying) {
+		getLog() << "Rewinding is disabled while recording a replay" << std::endl;
+		return;
+	}
+	if (lockstep) {
+		getLog() << "Rewinding is disabled in network matches" << std::endl;
+		return;
+	}
+	const WorldSnapshot* snapshot = snapshots->findTick(tick > ticks ? tick - ticks : 0);
+	if (!snapshot) {
+		snapshot = snapshots->getOldest();
+	}
+	if (!snapshot) {
+		return;
+	}
+	restoreSnapshot(*snapshot);
+	snapshots->discardAfter(tick);
+	rewound = true;
+
+	//The inputs of the restored tick are part of the snapshot, the replay continues with the changes after it
+	if (replaying) {
+		const std::vector<Replay::InputChange>& inputChanges = replay->getInputChanges();
+		replayPosition = 0;
+		while (replayPosition < inputChanges.size() && inputChanges[replayPosition].tick <= tick) {
+			replayPosition++;
+		}
+		replayFinished = false;
+	}
+	getLog() << "Rewound to tick " << tick << std::endl;
+}
+
+void Game::planComputers() {
+	ProfileScope scope(profiler, Profiler::AI_PLANNING);
+	plannedComputers.clear();
+	for (auto& computer : computers) {
+		if (!computer->isToBeRemoved()) {
+			plannedComputers.push_back(computer.get());
+			//The distance field entries are created here, the planning threads only compute into their own entry
+			if (distanceFields.find(computer.get()) == distanceFields.end()) {
+				distanceFields.emplace(computer.get(), DistanceField());
+			}
+		}
+	}
+	workerPool->run(plannedComputers.size(), [this](size_t i) {
+		plannedComputers[i]->planUpdate(this);
+	});
 }
 
 void Game::render() const {
 	SDL_SetRenderTarget(renderer, gameDisplay);
 	SDL_RenderClear(renderer);
 
-	map->render(renderer);
-	entityManager->renderEntities(renderer);
+	{
+		ProfileScope scope(profiler, Profiler::MAP_RENDER);
+		map->render(*spriteBatch, showAI);
+	}
+	{
+		ProfileScope scope(profiler, Profiler::ENTITY_RENDER);
+		entityManager->renderEntities(*spriteBatch, drawWireframes);
+	}
+	{
+		ProfileScope scope(profiler, Profiler::PARTICLE_RENDER);
+		particleSystem->render(*spriteBatch);
+	}
 	
 	SDL_SetRenderTarget(renderer, NULL);
 	SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
 	SDL_RenderClear(renderer);
 	SDL_RenderCopy(renderer, gameDisplay, NULL, &gameDisplayRect);
 
-	infoBar->render(renderer, this);
+	{
+		ProfileScope scope(profiler, Profiler::INFO_BAR_RENDER);
+		infoBar->render(*spriteBatch, this);
+	}
 
 	if (endOfGame) renderEndOfGame();
+
+	if (profiler->isOverlayVisible()) {
+		profiler->renderOverlay(*spriteBatch, gameDisplayRect, *smallerFontGlyphs, fontColor);
+	}
 	
 	SDL_RenderPresent(renderer);
 }
@@ -372,6 +840,10 @@ void Game::handleEvents() {
 			case SDL_KEYUP:
 				handleKeyUp(&event.key, keys);
 				break;
+			case SDL_RENDER_TARGETS_RESET:
+				//The content of render target textures was lost
+				map->invalidateTileLayer();
+				break;
 			default:
 				break;
 		}
@@ -396,35 +868,74 @@ void Game::handleKeyDown(SDL_KeyboardEvent* event, const Uint8 * keys) {
 		if (event->keysym.scancode == SDL_SCANCODE_F3) {
 			debug = !debug;
 		}
+		if (event->keysym.scancode == SDL_SCANCODE_F5) {
+			profiler->toggleOverlay();
+		}
+		if (event->keysym.scancode == SDL_SCANCODE_F6) {
+			rewind(Constants::REWIND_TICKS);
+		}
 	}
 
+	if (replaying || lockstep) {
+		return;
+	}
 	for (auto& player : players) {
 		player->handleKeyDown(event);
 	}
 }
 
 void Game::handleKeyUp(SDL_KeyboardEvent* event, const Uint8 * keys) {
+	if (replaying || lockstep) {
+		return;
+	}
 	for (auto& player : players) {
 		player->handleKeyUp(event);
 	}
 }
 
 void Game::handleKeyHeldDown(const Uint8* keys) {
+	if (replaying) {
+		return;
+	}
+	//The players of a network match are controlled by the inputs of the session, only the local ones by the keyboard
+	if (lockstep) {
+		for (auto& player : players) {
+			lockstep->setLocalInput(player->getPlayerId(), player->getKeyboardInput(keys));
+		}
+		return;
+	}
 	for (auto& player : players) {
 		player->handleKeyHeldDown(keys);
 	}
 }
 
 void Game::dispose() const {
-	std::cout << "Calling dispose" << std::endl;
+	getLog() << "Calling dispose" << std::endl;
 
 	//Freeing textures
-	TextureManager::dispose();
+	if (!headless) {
+		TextureManager::dispose();
+	}
 
 	//Freeing game components
 	delete infoBar;
 	delete entityManager;
+	delete particleSystem;
 	delete map;
+	delete workerPool;
+	delete profiler;
+	delete spriteBatch;
+	delete fontGlyphs;
+	delete smallerFontGlyphs;
+	delete textCache;
+	delete replay;
+	delete snapshots;
+	delete lockstep;
+
+	//Headless games never initialise SDL, the libraries are left alone for other games
+	if (headless) {
+		return;
+	}
 
 	//Freeing SDL_ttf
 	if (TTF_WasInit() == 1) {
@@ -445,28 +956,124 @@ void Game::dispose() const {
 }
 
 void Game::gameloop() {
-	std::cout << "Starting gameloop" << std::endl;
+	getLog() << "Starting gameloop" << std::endl;
 
-	int frameDelay;
-	Uint32 frameStart;
-	int frameTime;
+	const double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+	const double tickDuration = 1.0 / Constants::TARGET_FPS;
+
+	//Scaled game time that passed and was not simulated yet, in seconds
+	double accumulator = 0;
+	Uint64 previousTime = SDL_GetPerformanceCounter();
 
 	while (isRunning) {
-		frameStart = SDL_GetTicks();
-		frameDelay = slowMo ? 1000 / Constants::SLOWMO_FPS : 1000 / Constants::TARGET_FPS;
+		const Uint64 currentTime = SDL_GetPerformanceCounter();
+		const double scale = slowMo ? timeScale * Constants::SLOWMO_TIME_SCALE : timeScale;
+		accumulator += static_cast<double>(currentTime - previousTime) / frequency * scale;
+		previousTime = currentTime;
+
+		{
+			ProfileScope scope(profiler, Profiler::EVENTS);
+			handleEvents();
+		}
+
+		//Simulate all ticks that are due. If the updates take longer than the game time they simulate
+		//the simulation would fall behind more with every frame, the time that can't be caught up on is dropped.
+		int ticks = 0;
+		while (accumulator >= tickDuration && ticks < Constants::MAX_TICKS_PER_FRAME && isNextTickReady()) {
+			update();
+			accumulator -= tickDuration;
+			ticks++;
+		}
+		if (accumulator >= tickDuration) {
+			accumulator = std::fmod(accumulator, tickDuration);
+		}
 
-		handleEvents();
-		update();
 		render();
+		profiler->endFrame();
+
+		//Without vsync presenting does not wait, sleep until the next tick is due instead of rendering the same state again
+		if (!vsyncActive && scale > 0) {
+			const double secondsToNextTick = (tickDuration - accumulator) / scale;
+			const double secondsElapsed = static_cast<double>(SDL_GetPerformanceCounter() - previousTime) / frequency;
+			if (secondsToNextTick > secondsElapsed) {
+				SDL_Delay(static_cast<Uint32>((secondsToNextTick - secondsElapsed) * 1000));
+			}
+		}
+	}
 
-		frameTime = SDL_GetTicks() - frameStart;
+	saveReplay();
+}
 
-		if (frameDelay > frameTime) {
-			SDL_Delay(frameDelay - frameTime);
+void Game::headlessGameloop() {
+	getLog() << "Starting headless gameloop" << std::endl;
+
+	const int lingerMs = Constants::LOCKSTEP_LINGER_MS;
+	bool endConfirmed = false;
+	std::chrono::steady_clock::time_point endConfirmedTime;
+	while (isRunning) {
+		//A network match waits for the inputs of the peer
+		const bool nextTickReady = isNextTickReady();
+
+		//The end of a network match may still be rolled back until the inputs of its ticks are confirmed.
+		//Then the game keeps answering the peer for a while, until the peer received the inputs up to the end as well.
+		if (isEndOfGameFinal()) {
+			const auto now = std::chrono::steady_clock::now();
+			if (!endConfirmed) {
+				endConfirmed = true;
+				endConfirmedTime = now;
+			}
+			if (!lockstep || lockstep->isPeerConfirmed(tick) || now - endConfirmedTime >= std::chrono::milliseconds(lingerMs)) {
+				isRunning = false;
+			} else {
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+			continue;
+		}
+		if (!nextTickReady || endOfGame) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			continue;
 		}
+		//The limit is checked before simulating the next tick, a rolled back match may not have reached it anymore
+		if (!replaying && maxTicks > 0 && tick >= maxTicks) {
+			handleEndOfGame("Tick limit reached");
+		} else {
+			update();
+			profiler->endFrame();
+		}
+	}
+
+	saveReplay();
+	printMatchSummary();
+}
+
+void Game::printMatchSummary() const {
+	getLog() << "Match summary" << std::endl;
+	getLog() << "Result: " << endOfGameMessage << std::endl;
+	for (auto& line : getMatchOutcome()) {
+		getLog() << line << std::endl;
 	}
 }
 
+std::vector<std::string> Game::getMatchOutcome() const {
+	const Bomberman* winner = getWinner();
+
+	std::vector<std::string> outcome;
+	outcome.push_back("Winner: " + (winner ? getBombermanName(winner) : std::string("none")));
+	outcome.push_back("Ticks: " + std::to_string(tick));
+	outcome.push_back("Scores:");
+	for (auto& player : players) {
+		std::ostringstream oss;
+		oss << "  " << getBombermanName(player.get()) << ": " << player->getScore() << " (health " << player->getHealth() << ")";
+		outcome.push_back(oss.str());
+	}
+	for (auto& computer : computers) {
+		std::ostringstream oss;
+		oss << "  " << getBombermanName(computer.get()) << ": " << computer->getScore() << " (health " << computer->getHealth() << ")";
+		outcome.push_back(oss.str());
+	}
+	return outcome;
+}
+
 void Game::handleEndOfGame(std::string message) {
 	endOfGame = true;
 	endOfGameMessage = message;
@@ -476,19 +1083,11 @@ void Game::renderEndOfGame() const {
 	SDL_Rect bannerRect{ gameDisplayRect.x, gameDisplayRect.y + gameDisplayRect.h / 2 - 20, gameDisplayRect.w, 40 };
 	SDL_RenderFillRect(renderer, &bannerRect);
 
-	SDL_Surface* endText = TTF_RenderText_Solid(font, endOfGameMessage.c_str(), fontColor);
-	SDL_Texture* endTextTexture = SDL_CreateTextureFromSurface(renderer, endText);
-	int textWidth = 0;
-	int textHeight = 0;
-	TTF_SizeText(font, endOfGameMessage.c_str(), &textWidth, &textHeight);
-	SDL_Rect endTextTextureRect{ bannerRect.x + bannerRect.w /2 - textWidth/2, bannerRect.y + bannerRect.h/2 - textHeight/2,textWidth, textHeight };
-	SDL_RenderCopy(renderer, endTextTexture, NULL, &endTextTextureRect);
-	SDL_FreeSurface(endText);
-	SDL_DestroyTexture(endTextTexture);
+	textCache->renderText("endOfGame", endOfGameMessage, bannerRect, Renderer::TextAlign::CenterCenter, font, fontColor);
 }
 
 void Game::loadConfigFile(const char* configFile) {	
-	std::cout << "Loading configuration file" << std::endl;
+	getLog() << "Loading configuration file" << std::endl;
 	std::string configContent = FileUtils::loadStringFromFile(configFile);
 	std::istringstream contentStream(configContent);
 	std::string line;
@@ -512,22 +1111,122 @@ void Game::loadConfigFile(const char* configFile) {
 
 void Game::loadConfigEntry(const std::string& key, const std::string& value) {
 	if (key == "map") {
-		std::cout << "Using custom map " << value << std::endl;
+		getLog() << "Using custom map " << value << std::endl;
 		this->useCustomMap = true;
 		this->customMapFile = value;
 	} else
 	if (key == "A") {
-		std::cout << "Player A = " << value << std::endl;
+		getLog() << "Player A = " << value << std::endl;
 		playerNames.insert(std::pair<char, std::string>('A', value));
 	} else
 	if (key == "B") {
-		std::cout << "Player B = " << value << std::endl;
+		getLog() << "Player B = " << value << std::endl;
 		playerNames.insert(std::pair<char, std::string>('B', value));
+	} else
+	if (key == "headless") {
+		this->headless = this->headless || value == "1" || value == "true";
+	} else
+	if (key == "maxTicks") {
+		try {
+			this->maxTicks = static_cast<unsigned int>(std::stoul(value));
+		} catch (const std::logic_error& e) {
+			std::cerr << "Invalid maxTicks value " << value << std::endl;
+		}
+	} else
+	if (key == "timeScale") {
+		try {
+			const double scale = std::stod(value);
+			if (scale >= 0) {
+				this->timeScale = scale;
+			} else {
+				std::cerr << "Invalid timeScale value " << value << std::endl;
+			}
+		} catch (const std::logic_error& e) {
+			std::cerr << "Invalid timeScale value " << value << std::endl;
+		}
+	} else
+	if (key == "vsync") {
+		this->vsync = value == "1" || value == "true";
+	} else
+	if (key == "profilerFile") {
+		this->profilerFile = value;
+	} else
+	if (key == "seed") {
+		try {
+			if (!seedFromCommandLine) {
+				this->seed = std::stoull(value);
+				this->seedSpecified = true;
+			}
+		} catch (const std::logic_error& e) {
+			std::cerr << "Invalid seed value " << value << std::endl;
+		}
+	} else
+	if (key == "replay") {
+		this->replayFile = value;
+	} else
+	if (key == "recordReplay") {
+		this->recordReplayFile = value;
+	} else
+	if (key == "aiThreads") {
+		try {
+			this->aiThreads = static_cast<unsigned int>(std::stoul(value));
+		} catch (const std::logic_error& e) {
+			std::cerr << "Invalid aiThreads value " << value << std::endl;
+		}
+	} else
+	if (key == "snapshotHistory") {
+		try {
+			this->snapshotHistory = static_cast<unsigned int>(std::stoul(value));
+		} catch (const std::logic_error& e) {
+			std::cerr << "Invalid snapshotHistory value " << value << std::endl;
+		}
+	} else
+	if (key == "lockstepPort") {
+		try {
+			const unsigned long port = std::stoul(value);
+			if (port <= 65535) {
+				this->lockstepPort = static_cast<unsigned int>(port);
+			} else {
+				std::cerr << "Invalid lockstepPort value " << value << std::endl;
+			}
+		} catch (const std::logic_error& e) {
+			std::cerr << "Invalid lockstepPort value " << value << std::endl;
+		}
+	} else
+	if (key == "lockstepPeer") {
+		this->lockstepPeer = value;
+	} else
+	if (key == "lockstepPlayers") {
+		this->lockstepPlayers = value;
+	} else
+	if (key == "rollbackTicks") {
+		try {
+			const unsigned long ticks = std::stoul(value);
+			if (ticks <= Constants::ROLLBACK_MAX_TICKS) {
+				this->rollbackTicks = static_cast<unsigned int>(ticks);
+			} else {
+				std::cerr << "Invalid rollbackTicks value " << value << ", the maximum is " << Constants::ROLLBACK_MAX_TICKS << std::endl;
+			}
+		} catch (const std::logic_error& e) {
+			std::cerr << "Invalid rollbackTicks value " << value << std::endl;
+		}
+	} else
+	if (key == "lockstepInputDelay") {
+		try {
+			const unsigned long delay = std::stoul(value);
+			if (delay <= Constants::LOCKSTEP_MAX_INPUT_DELAY) {
+				this->lockstepInputDelay = static_cast<unsigned int>(delay);
+			} else {
+				std::cerr << "Invalid lockstepInputDelay value " << value << ", the maximum is " << Constants::LOCKSTEP_MAX_INPUT_DELAY << std::endl;
+			}
+		} catch (const std::logic_error& e) {
+			std::cerr << "Invalid lockstepInputDelay value " << value << std::endl;
+		}
 	}
 }
 
 void Game::loadHighscores(const char* highscoreFile) {
-	std::cout << "Loading highscores file" << std::endl;
+	getLog() << "Loading highscores file" << std::endl;
 	std::string highscoreContent = FileUtils::loadStringFromFile(highscoreFile);
 	std::istringstream highscoreStream(highscoreContent);
 	std::string line;
@@ -656,13 +1355,18 @@ bool Game::initialiseSDL(const char* title, int windowX, int windowY, int window
 			return false;
 		}
 
-		renderer = SDL_CreateRenderer(window, -1, 0);
+		renderer = SDL_CreateRenderer(window, -1, vsync ? SDL_RENDERER_PRESENTVSYNC : 0);
 		if (!renderer) {
 			std::cerr << "Failed to initialise renderer!" << std::endl;
 			std::cerr << SDL_GetError() << std::endl;
 			return false;
 		}
 
+		//The vsync flag is only a request, check whether the renderer honours it
+		SDL_RendererInfo rendererInfo;
+		vsyncActive = SDL_GetRendererInfo(renderer, &rendererInfo) == 0 && (rendererInfo.flags & SDL_RENDERER_PRESENTVSYNC) != 0;
+		getLog() << "Vsync " << (vsyncActive ? "enabled" : "disabled") << std::endl;
+
 		if (TTF_Init() == -1) {
 			std::cerr << "Failed to initialise SDL_ttf!" << std::endl;
 			std::cerr << TTF_GetError() << std::endl;
@@ -671,7 +1375,7 @@ bool Game::initialiseSDL(const char* title, int windowX, int windowY, int window
 		
 		SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
 		
-		std::cout << "SDL initialised" << std::endl;
+		getLog() << "SDL initialised" << std::endl;
 		isRunning = true;
 		return true;
 	} else {
@@ -685,10 +1389,75 @@ std::string Game::getTickString() const {
 	return std::to_string(tick) + "> ";
 }
 
+const DistanceField& Game::getDistanceField(const Bomberman* bomberman) {
+	auto it = distanceFields.find(bomberman);
+	if (it == distanceFields.end()) {
+		it = distanceFields.emplace(bomberman, DistanceField()).first;
+	}
+	DistanceField& field = it->second;
+	const Tile* tile = map->getTileAtCoordinates(bomberman->getCenterX(), bomberman->getCenterY());
+	if (!field.isComputed(tile, tick)) {
+		field.compute(*map, tile, tick);
+	}
+	return field;
+}
+
+Profiler* Game::getProfiler() const {
+	return profiler;
+}
+
 unsigned int Game::getTick() const {
 	return tick;
 }
 
+bool Game::isEndOfGame() const {
+	return endOfGame;
+}
+
+const Bomberman* Game::getWinner() const {
+	//The winner is the last bomberman standing, there is none if the match timed out with more survivors
+	const Bomberman* winner = nullptr;
+	int bombermenAlive = 0;
+	for (auto& bomberman : getBombermen()) {
+		if (bomberman->getHealth() > 0) {
+			winner = bomberman;
+			bombermenAlive++;
+		}
+	}
+	return bombermenAlive == 1 ? winner : nullptr;
+}
+
+std::vector<const Bomberman*> Game::getBombermen() const {
+	std::vector<const Bomberman*> bombermen;
+	for (auto& player : players) {
+		bombermen.push_back(player.get());
+	}
+	for (auto& computer : computers) {
+		bombermen.push_back(computer.get());
+	}
+	return bombermen;
+}
+
+unsigned int Game::getRollbackCount() const {
+	return rollbackCount;
+}
+
+std::ostream& Game::getLog() const {
+	return quiet || resimulating ? nullLog : std::cout;
+}
+
+void Game::setQuiet(bool quiet) {
+	this->quiet = quiet;
+}
+
+bool Game::isDebug() const {
+	return debug;
+}
+
+bool Game::isShowAI() const {
+	return showAI;
+}
+
 TTF_Font* Game::getFont() const {
 	return font;
 }
@@ -697,6 +1466,60 @@ TTF_Font* Game::getSmallerFont() const {
 	return smallerFont;
 }
 
+const GlyphAtlas* Game::getFontGlyphs() const {
+	return fontGlyphs;
+}
+
+TextCache* Game::getTextCache() const {
+	return textCache;
+}
+
 SDL_Color Game::getFontColor() const {
 	return fontColor;
+}
+
+bool Game::isHeadless() const {
+	return headless;
+}
+
+void Game::setHeadless(bool headless) {
+	this->headless = headless;
+}
+
+void Game::setTransport(std::unique_ptr<Transport> transport) {
+	this->transport = std::move(transport);
+}
+
+void Game::setLocalInput(char playerId, Uint8 input) {
+	if (lockstep) {
+		lockstep->setLocalInput(playerId, input);
+	}
+}
+
+void Game::setSeed(std::uint64_t seed) {
+	this->seed = seed;
+	this->seedSpecified = true;
+	this->seedFromCommandLine = true;
+}
+
+Random& Game::getMapRandom() {
+	return mapRandom;
+}
+
+Random& Game::getPowerUpRandom() {
+	return powerUpRandom;
+}
+
+std::string Game::getBombermanName(const Bomberman* bomberman) const {
+	for (auto& player : players) {
+		if (player.get() == bomberman) {
+			return "Player " + player->getNameOrId();
+		}
+	}
+	for (auto& computer : computers) {
+		if (computer.get() == bomberman) {
+			return "Computer " + std::to_string(computer->getID());
+		}
+	}
+	return "Unknown";
 }
\ No newline at end of file
@@ -3,7 +3,13 @@
 #include "SDL.h"
 #include <SDL_ttf.h>
 
+#include "Constants.h"
+#include "DistanceField.h"
+#include "EntityHandle.h"
+#include "Random.h"
+
 #include <memory>
+#include <ostream>
 #include <string>
 #include <map>
 #include <vector>
@@ -15,21 +21,25 @@ class GameInfoBar;
 class Map;
 struct MapData;
 class EntityManager;
+class ParticleSystem;
+class Bomberman;
+class WorkerPool;
+class Profiler;
+class SpriteBatch;
+class GlyphAtlas;
+class TextCache;
+class Replay;
+class Entity;
+struct WorldSnapshot;
+class SnapshotRing;
+class Transport;
+class LockstepSession;
 
 /*!
  * The main game representation handling the gameloop, game lifecycle and user input.
  */
 class Game {
 public:
-	/*! A debug flag for printing game info to console */
-	static bool debug;
-	/*! Enables entity wireframe drawing with F1 */
-	static bool drawWireframes;
-	/*! Switches to a slower framerate with F2 */
-	static bool slowMo;
-	/*! Displays pathfinding paths and dangerous tiles with F3 */
-	static bool showAI;
-
 	/*!
 	 * Vector containing all Players in the game
 	 * \see Constants::PLAYER_MAX_COUNT
@@ -40,8 +50,15 @@ public:
 	 * \see Constants::PLAYER_OR_COMPUTER_MAX_COUNT
 	 */
 	std::vector<std::shared_ptr<Computer>> computers;
+	/*!
+	 * Handles the players and computers were registered with, a dead bomberman is no longer managed
+	 * but can still be found by its handle.
+	 * \see getBomberman()
+	 */
+	std::vector<std::pair<EntityHandle, Bomberman*>> bombermanHandles;
 
 	EntityManager* entityManager = nullptr;
+	ParticleSystem* particleSystem = nullptr;
 	Map* map = nullptr;
 private:
 	/*! An unsigned integer that is incremented by one on every gameloop update */
@@ -50,9 +67,116 @@ private:
 	/*! Game state controlling the gameloop. */
 	bool isRunning = false;
 
+	//Debug switches are kept per game so that games running in parallel do not share any state
+	/*! A debug flag for printing game info to console, toggled with F3. */
+	bool debug = false;
+	/*! Enables entity wireframe drawing with F1. */
+	bool drawWireframes = false;
+	/*! Slows the game time down with F4. */
+	bool slowMo = false;
+	/*! Displays pathfinding paths and dangerous tiles with F2. */
+	bool showAI = false;
+
+	/*! Whether the console messages of the game are discarded, errors are still printed. */
+	bool quiet = false;
+	/*! Stream without a buffer that discards everything written to it, the log of a quiet game. */
+	mutable std::ostream nullLog{ nullptr };
+
 	/*! Whether an end condition was met. */
 	bool endOfGame = false;
 
+	/*!
+	 * Runs the simulation without a window, renderer, fonts or textures and without a frame cap.
+	 * The match runs until an end condition is met or Game::maxTicks is reached.
+	 */
+	bool headless = false;
+
+	/*! Speed of the game time relative to real time, the game ticks Constants::TARGET_FPS times per second at 1. */
+	double timeScale = 1;
+
+	/*! Whether rendering is synchronized with the display refresh rate. */
+	bool vsync = true;
+
+	/*! Whether the renderer actually waits for the display refresh when presenting a frame. */
+	bool vsyncActive = false;
+
+	/*! Number of ticks after which a headless match is stopped. 0 disables the limit. */
+	unsigned int maxTicks = Constants::HEADLESS_MAX_TICKS;
+
+	/*! Seed all random streams of the game are derived from. */
+	std::uint64_t seed = 0;
+	/*! Whether the seed was specified, a random seed is generated otherwise. */
+	bool seedSpecified = false;
+	/*! Whether the seed was specified on the command line, it takes precedence over the config file. */
+	bool seedFromCommandLine = false;
+
+	/*! Random stream of the map generation. */
+	Random mapRandom;
+	/*! Random stream of the power up drops. */
+	Random powerUpRandom;
+
+	/*! Distance fields of bombermen, each is computed at most once per tick. */
+	std::map<const Bomberman*, DistanceField> distanceFields;
+
+	/*! Replay file the match is played back from, empty to play a new match. */
+	std::string replayFile;
+	/*! Replay file the match is recorded to, empty to disable recording. */
+	std::string recordReplayFile;
+
+	/*! The replay being recorded or played back, nullptr if neither. */
+	Replay* replay = nullptr;
+	/*! Whether the players are controlled by the inputs of Game::replay instead of the keyboard. */
+	bool replaying = false;
+	/*! Index of the next input change of the played back replay. */
+	size_t replayPosition = 0;
+	/*! Whether the played back replay reached its end. */
+	bool replayFinished = false;
+
+	/*! Number of last ticks kept as snapshots to rewind the game with F6, 0 disables the history. */
+	unsigned int snapshotHistory = 0;
+	/*! Snapshots of the last ticks, nullptr if the history is disabled. */
+	SnapshotRing* snapshots = nullptr;
+	/*! Whether the match was rewound, rewound matches do not count towards highscores. */
+	bool rewound = false;
+	/*! Entities of the snapshot being restored, reused between restores. */
+	std::vector<Entity*> restoredEntities;
+
+	/*! Number of threads the computers plan on, 0 uses one thread per hardware thread. */
+	unsigned int aiThreads = 0;
+
+	/*! UDP port of a network match, the peer sends its inputs to it. */
+	unsigned int lockstepPort = 0;
+	/*! Address of the peer of a network match as host:port, empty to play locally. */
+	std::string lockstepPeer;
+	/*! Ids of the players controlled on this machine in a network match, the peer controls the others. */
+	std::string lockstepPlayers;
+	/*! Ticks between sampling a local input and simulating it in a network match, has to match the peer. */
+	unsigned int lockstepInputDelay = Constants::LOCKSTEP_INPUT_DELAY;
+	/*! Ticks a network match is simulated ahead of the inputs of the peer, 0 waits for the inputs instead. */
+	unsigned int rollbackTicks = Constants::ROLLBACK_TICKS;
+	/*! Whether mispredicted ticks are being simulated again, the console messages are discarded meanwhile. */
+	bool resimulating = false;
+	/*! Number of rollbacks of the network match. */
+	unsigned int rollbackCount = 0;
+	/*! Whether the end of the match was handled, see finishMatch(). */
+	bool matchFinished = false;
+	/*! Connection to the peer set before the game was started, used instead of lockstepPeer. */
+	std::unique_ptr<Transport> transport;
+	/*! The inputs of the network match, nullptr when playing locally. */
+	LockstepSession* lockstep = nullptr;
+
+	/*! Frame time measurements, the overlay is toggled with F5. */
+	Profiler* profiler = nullptr;
+
+	/*! CSV file the profiler streams frame times to, empty to disable. */
+	std::string profilerFile;
+
+	/*! Threads the computers plan on. */
+	WorkerPool* workerPool = nullptr;
+
+	/*! Computers planning in the current tick, reused between ticks. */
+	std::vector<Computer*> plannedComputers;
+
 	/*! Message displayed on game end. */
 	std::string endOfGameMessage;
 	
@@ -66,11 +190,21 @@ private:
 	SDL_Rect gameDisplayRect{};
 	SDL_Texture* gameDisplay = nullptr;
 
+	/*! Batches the map and entity sprites into few draw calls. */
+	SpriteBatch* spriteBatch = nullptr;
+
 	TTF_Font* font = nullptr;
 	int fontSize = 16;
 
 	TTF_Font* smallerFont = nullptr;
 	int smallerFontSize = 12;
+
+	/*! Glyphs of the fonts for texts that change every frame. */
+	GlyphAtlas* fontGlyphs = nullptr;
+	GlyphAtlas* smallerFontGlyphs = nullptr;
+
+	/*! Textures of texts that rarely change. */
+	TextCache* textCache = nullptr;
 	
 	SDL_Color fontColor = { 255, 255, 255 };
 
@@ -120,6 +254,63 @@ public:
 	 */
 	bool run(const char* configFile);
 
+	/*!
+	 * Loads the configuration file and initialises the game without starting the gameloop.
+	 * The game can then be advanced tick by tick with update().
+	 *
+	 * \return true on success, false if the game failed to initialise.
+	 * \see run()
+	 */
+	bool load(const char* configFile);
+
+	/*!
+	 * Game update method. Called by the game loop in order to update various game components.
+	 */
+	void update();
+
+	/*!
+	 * Whether the next tick can be simulated with update(). A network match waits for the inputs of the peer,
+	 * the match ends when the connection fails. A local game is always ready.
+	 * A network match keeps exchanging packets after it ended, the peer may still need the last inputs.
+	 */
+	bool isNextTickReady();
+
+	/*!
+	 * Whether the simulation up to the current tick can't change anymore, always true for local games.
+	 * A network match simulated ahead of the inputs of the peer may still roll the ticks back.
+	 */
+	bool isTickConfirmed() const;
+
+	/*!
+	 * Whether the match ended and the end can't change anymore.
+	 * The end of a network match is only final once the inputs of all its ticks are confirmed.
+	 */
+	bool isEndOfGameFinal() const;
+
+	/*!
+	 * Attempts to load individual config key - value pairs.
+	 * Can also be used to configure the game before it is loaded.
+	 * 
+	 * \param key Config key
+	 * \param value Config value
+	 */
+	void loadConfigEntry(const std::string& key, const std::string& value);
+
+	/*!
+	 * Captures the simulation state at the end of the current tick.
+	 *
+	 * \param snapshot The snapshot to overwrite, its memory is reused.
+	 */
+	void captureSnapshot(WorldSnapshot& snapshot) const;
+
+	/*!
+	 * Puts the game back into the state of a snapshot captured by this game.
+	 * The game continues from the tick after the snapshot tick, the inputs of the players are those of the snapshot.
+	 *
+	 * \param snapshot The snapshot.
+	 */
+	void restoreSnapshot(const WorldSnapshot& snapshot);
+
 	/*!
 	 * Registers a new player with a playerId at a specified tile.
 	 * 
@@ -136,6 +327,12 @@ public:
 	 * \throws std::runtime_error
 	 */
 	void registerComputer(Tile* tile);
+
+	/*!
+	 * Returns the player or computer registered with the handle, also when it died since, nullptr if there is none.
+	 * Bombs and explosions credit their bomberman even after its death.
+	 */
+	Bomberman* getBomberman(EntityHandle handle) const;
 private:
 	/*!
 	 * Initialises the game.
@@ -151,9 +348,12 @@ private:
 	bool loadFonts();
 
 	/*!
-	 * Game update method. Called by the game loop in order to update various game components.
+	 * Lets all computers plan their actions in parallel before the entities are updated.
+	 * Planning only reads the game state, the computers apply their plans serially in their own updates.
+	 *
+	 * \see Computer::planUpdate()
 	 */
-	void update();
+	void planComputers();
 
 	/*!
 	 * Game render method. Called by the game loop to draw game to screen.
@@ -196,9 +396,81 @@ private:
 
 	/*!
 	 * Starts the gameloop. This method takes up the current thread until its stopped internally.
+	 *
+	 * The game is updated with a fixed timestep of Constants::TARGET_FPS ticks per second of scaled time
+	 * independently of the rendering. A frame is rendered after the due ticks are simulated,
+	 * as often as the display refresh rate allows when vsync is active.
 	 */
 	void gameloop();
 
+	/*!
+	 * Starts the headless gameloop. Updates the game as fast as possible without handling events or rendering
+	 * until an end condition is met or the tick limit is reached, then prints the match summary.
+	 */
+	void headlessGameloop();
+
+	/*!
+	 * Prints the match result, tick count and bomberman scores to the console.
+	 */
+	void printMatchSummary() const;
+
+	/*!
+	 * Returns the lines of the match summary describing the state of the match, the winner, tick count and scores.
+	 * Matches played out the same way have the same outcome.
+	 */
+	std::vector<std::string> getMatchOutcome() const;
+
+	/*!
+	 * Records the inputs of the players for the current tick, or applies the inputs of the played back replay.
+	 */
+	void updateReplayInputs();
+
+	/*!
+	 * Connects to the peer of a network match if one is configured.
+	 *
+	 * \return true on success or when playing locally, false if the connection failed.
+	 */
+	bool initLockstep();
+
+	/*!
+	 * Controls the players with the inputs of the network match for the current tick.
+	 */
+	void updateLockstepInputs();
+
+	/*!
+	 * Simulates the ticks of a network match again from the first tick with a mispredicted remote input,
+	 * the state before it is restored from the snapshot history.
+	 *
+	 * \throws std::runtime_error if the snapshot before the tick is no longer kept.
+	 */
+	void rollback();
+
+	/*!
+	 * Ends the network match, the rest of the match is played locally.
+	 */
+	void stopLockstep(const std::string& message);
+
+	/*!
+	 * Writes the highscores once the end of the match is final.
+	 */
+	void finishMatch();
+
+	/*!
+	 * Ends the played back replay and compares the outcome of the match with the recorded one.
+	 */
+	void finishReplay();
+
+	/*!
+	 * Saves the recorded replay with the outcome of the match.
+	 */
+	void saveReplay() const;
+
+	/*!
+	 * Restores the snapshot of the history from the specified number of ticks ago, or the oldest one if the history is shorter.
+	 * The snapshots of the rewound ticks are discarded.
+	 */
+	void rewind(unsigned int ticks);
+
 	/*!
 	 * Sets the end of game message to be displayed.
 	 */
@@ -220,14 +492,6 @@ private:
 	 */
 	void loadConfigFile(const char* configFile);
 
-	/*!
-	 * Attempts to load individual config key - value pairs.
-	 * 
-	 * \param key Config key
-	 * \param value Config value
-	 */
-	void loadConfigEntry(const std::string& key, const std::string& value);
-
 	/*!
 	 * Loads and parses the highscore file.
 	 * 
@@ -282,6 +546,57 @@ public:
 	 */
 	unsigned int getTick() const;
 
+	/*!
+	 * Whether an end condition of the match was met.
+	 */
+	bool isEndOfGame() const;
+
+	/*!
+	 * Returns the last bomberman alive, nullptr if more bombermen are alive or none is.
+	 */
+	const Bomberman* getWinner() const;
+
+	/*!
+	 * Returns how many times the network match was rolled back to correct mispredicted inputs.
+	 */
+	unsigned int getRollbackCount() const;
+
+	/*!
+	 * Returns the players followed by the computers, including the dead ones.
+	 */
+	std::vector<const Bomberman*> getBombermen() const;
+
+	/*!
+	 * Returns the stream the console messages of the game are written to.
+	 * The messages of a quiet game are discarded.
+	 */
+	std::ostream& getLog() const;
+
+	/*!
+	 * Sets whether the console messages of the game are discarded.
+	 * Errors are printed to std::cerr regardless.
+	 */
+	void setQuiet(bool quiet);
+
+	/*! Whether debug messages are printed to the log. */
+	bool isDebug() const;
+
+	/*! Whether AI paths and dangerous tiles are displayed and AI decisions are logged. */
+	bool isShowAI() const;
+
+	/*!
+	 * Returns walking distances from the tile the bomberman stands on to all tiles of the map.
+	 * The field is computed on the first request in a tick and cached for the rest of the tick,
+	 * so all AIs can query it without running their own searches.
+	 * During planComputers() a computer may only request its own field.
+	 */
+	const DistanceField& getDistanceField(const Bomberman* bomberman);
+
+	/*!
+	 * Returns the profiler measuring the frame times of the game subsystems.
+	 */
+	Profiler* getProfiler() const;
+
 	/*!
 	 * Returns the main game font.
 	 */
@@ -289,8 +604,65 @@ public:
 
 	TTF_Font* getSmallerFont() const;
 
+	/*!
+	 * Returns the glyph atlas of the main game font.
+	 */
+	const GlyphAtlas* getFontGlyphs() const;
+
+	/*!
+	 * Returns the cache of rendered text textures.
+	 */
+	TextCache* getTextCache() const;
+
 	/*!
 	 * Returns the game font color.
 	 */
 	SDL_Color getFontColor() const;
+
+	/*!
+	 * Whether the game runs without a window, renderer, fonts or textures.
+	 */
+	bool isHeadless() const;
+
+	/*!
+	 * Sets whether the game runs without a window, renderer, fonts or textures.
+	 * Has to be set before the game is started.
+	 */
+	void setHeadless(bool headless);
+
+	/*!
+	 * Sets the seed of the game, overriding the seed from the config file.
+	 * A match started with the same seed, map and inputs plays out the same way.
+	 * Has to be set before the game is started.
+	 */
+	void setSeed(std::uint64_t seed);
+
+	/*!
+	 * Plays a network match with the peer on the other end of the transport instead of the peer of the config.
+	 * The players listed by lockstepPlayers in the config are controlled on this side.
+	 * Has to be set before the game is started.
+	 */
+	void setTransport(std::unique_ptr<Transport> transport);
+
+	/*!
+	 * Sets the input of a player controlled on this side of a network match, used to control players of headless games.
+	 * Windowed games read the input from the keyboard.
+	 * \see Player::Input
+	 */
+	void setLocalInput(char playerId, Uint8 input);
+
+	/*!
+	 * Returns the random stream used to generate the map.
+	 */
+	Random& getMapRandom();
+
+	/*!
+	 * Returns the random stream used for power up drops.
+	 */
+	Random& getPowerUpRandom();
+
+	/*!
+	 * Returns a display name of a bomberman ("Player A", "Computer 1").
+	 */
+	std::string getBombermanName(const Bomberman* bomberman) const;
 };
@@ -5,12 +5,17 @@
 
 #include "Bomberman.h"
 #include "Entity.h"
+#include "SpriteBatch.h"
+
+#include <string>
 
 class Computer;
 class Player;
 
 /*!
  * A UI element used to indicate player / computer status.
+ * The icons and the frequently changing numbers are drawn with the sprite batch and the glyph atlas of the game font,
+ * the names are drawn through the text cache of the game.
  */
 class GameInfoBar {
 private:
@@ -19,15 +24,20 @@ private:
 public:
 	GameInfoBar(int x, int y, int width, int height);
 	
-	void render(SDL_Renderer* renderer, const Game* game) const;
+	/*!
+	 * Renders the info of all bombermen, the sprite batch is flushed before returning.
+	 */
+	void render(SpriteBatch& batch, const Game* game) const;
 
 	/*!
 	 * Displays game information for the bomberman. (Player or Computer)
 	 * 
 	 * \param index Index of the info display box.
 	 * \param bomberman The bomberman.
-	 * \param renderer The renderer.
+	 * \param icon Icon of the bomberman type.
+	 * \param name Name of the bomberman.
+	 * \param batch The sprite batch.
 	 * \param game The game.
 	 */
-	void renderBombermanInfo(int index, Bomberman* bomberman, SDL_Renderer* renderer, const Game* game) const;
+	void renderBombermanInfo(int index, Bomberman* bomberman, const TextureRegion& icon, const std::string& name, SpriteBatch& batch, const Game* game) const;
 };
@@ -0,0 +1,61 @@
+#include "GlyphAtlas.h"
+
+const char GlyphAtlas::FIRST_CHARACTER;
+const char GlyphAtlas::LAST_CHARACTER;
+
+GlyphAtlas::GlyphAtlas(TTF_Font* font, SDL_Renderer* renderer) : lineHeight(TTF_FontHeight(font)) {
+	const SDL_Color white{ 255, 255, 255, 255 };
+	std::vector<int> imageIds;
+	for (char character = FIRST_CHARACTER; character <= LAST_CHARACTER; character++) {
+		//Rendering single character strings, the surface width is the advance of the glyph
+		const char text[2] = { character, '\0' };
+		SDL_Surface* surface = TTF_RenderText_Solid(font, text, white);
+		glyphs.push_back(Glyph{ TextureRegion(), surface ? surface->w : 0 });
+		imageIds.push_back(atlas.addSurface(std::string("glyph ") + text, surface));
+	}
+	atlas.build(renderer);
+	for (size_t i = 0; i < glyphs.size(); i++) {
+		glyphs[i].region = atlas.getRegion(imageIds[i]);
+	}
+}
+
+bool GlyphAtlas::canRender(const std::string& text) const {
+	for (const char character : text) {
+		if (!getGlyph(character)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+SDL_Point GlyphAtlas::getTextSize(const std::string& text) const {
+	SDL_Point size{ 0, lineHeight };
+	for (const char character : text) {
+		if (const Glyph* glyph = getGlyph(character)) {
+			size.x += glyph->advance;
+		}
+	}
+	return size;
+}
+
+void GlyphAtlas::renderText(const std::string& text, const SDL_Rect& targetRect, Renderer::TextAlign textAlign, SDL_Color color, SpriteBatch& batch) const {
+	//The text alpha is ignored like by the TTF solid text rendering
+	color.a = 255;
+	const SDL_Point size = getTextSize(text);
+	const SDL_Rect textRect = Renderer::alignText(targetRect, size.x, size.y, textAlign);
+	int x = textRect.x;
+	for (const char character : text) {
+		if (const Glyph* glyph = getGlyph(character)) {
+			const SDL_Rect glyphRect{ x, textRect.y, glyph->region.rect.w, glyph->region.rect.h };
+			batch.draw(glyph->region.texture, glyph->region.rect, glyphRect, color);
+			x += glyph->advance;
+		}
+	}
+}
+
+const GlyphAtlas::Glyph* GlyphAtlas::getGlyph(char character) const {
+	if (character < FIRST_CHARACTER || character > LAST_CHARACTER) {
+		return nullptr;
+	}
+	return &glyphs[character - FIRST_CHARACTER];
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "SDL.h"
+#include <SDL_ttf.h>
+
+#include "TextureAtlas.h"
+#include "SpriteBatch.h"
+#include "Renderer.h"
+
+#include <string>
+#include <vector>
+
+/*!
+ * Renders text of a font from a texture atlas of its glyphs.
+ *
+ * The printable ASCII characters are rendered once when the atlas is created, white, so that any text colour
+ * can be applied as a colour modulation. A text is then drawn as one sprite batch quad per character,
+ * without rendering or uploading anything. Kerning is ignored, which matches the pixel font of the game.
+ */
+class GlyphAtlas {
+public:
+	static const char FIRST_CHARACTER = ' ';
+	static const char LAST_CHARACTER = '~';
+private:
+	struct Glyph {
+		TextureRegion region;
+		/*! Horizontal distance to the next glyph. */
+		int advance;
+	};
+
+	TextureAtlas atlas;
+	/*! Glyphs of the characters from FIRST_CHARACTER to LAST_CHARACTER. */
+	std::vector<Glyph> glyphs;
+	int lineHeight;
+public:
+	/*!
+	 * Renders the glyphs of a font and packs them into a texture atlas.
+	 */
+	GlyphAtlas(TTF_Font* font, SDL_Renderer* renderer);
+
+	/*!
+	 * Whether all characters of the text are in the atlas.
+	 */
+	bool canRender(const std::string& text) const;
+
+	/*!
+	 * Returns the width and height of a text rendered with the atlas.
+	 */
+	SDL_Point getTextSize(const std::string& text) const;
+
+	/*!
+	 * Renders aligned text, characters that are not in the atlas are skipped. The text is opaque, the alpha of the colour is ignored.
+	 *
+	 * \param text The text content.
+	 * \param targetRect Destination rectangle, width and height may be optional based on alignment.
+	 * \param textAlign Text alignment.
+	 * \param color Color of the text.
+	 * \param batch The sprite batch the glyphs are drawn with.
+	 */
+	void renderText(const std::string& text, const SDL_Rect& targetRect, Renderer::TextAlign textAlign, SDL_Color color, SpriteBatch& batch) const;
+private:
+	const Glyph* getGlyph(char character) const;
+};
@@ -4,16 +4,22 @@
 #include "EntityManager.h"
 #include "Game.h"
 #include "TextureManager.h"
+#include "WorldSnapshot.h"
 
 HealthPickup::HealthPickup(int initialX, int initialY)
 : PowerUp(TextureManager::health, initialX, initialY) {
 	
 }
 
+void HealthPickup::saveState(EntityState& state, WorldSnapshot& snapshot) const {
+	PowerUp::saveState(state, snapshot);
+	state.type = EntityState::HEALTH_PICKUP;
+}
+
 void HealthPickup::applyEffects(Game* game) {
 	for (auto& entity : potentialCollectors) {
-		Entity* entityPtr = entity.get();
-		if (Bomberman* bomberman = dynamic_cast<Bomberman*>(entityPtr)) {
+		if (entity->isBomberman()) {
+			Bomberman* bomberman = static_cast<Bomberman*>(entity.get());
 			bomberman->setHealth(bomberman->getHealth() + 1);
 			changeScore(bomberman);
 			game->entityManager->removeEntity(this);
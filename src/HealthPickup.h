@@ -12,6 +12,8 @@ public:
 	 */
 	HealthPickup(int initialX, int initialY);
 
+	void saveState(EntityState& state, WorldSnapshot& snapshot) const override;
+
 protected:
 	void applyEffects(Game* game) override;
 };
@@ -0,0 +1,244 @@
+#include "LockstepSession.h"
+
+#include "Constants.h"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+const Uint8 LockstepSession::NO_PREDICTION;
+
+namespace {
+
+const Uint8 PROTOCOL_VERSION = 1;
+const std::size_t HEADER_SIZE = 16;
+
+void writeUint32(std::vector<Uint8>& packet, Uint32 value) {
+	for (int i = 0; i < 4; i++) {
+		packet.push_back(static_cast<Uint8>(value >> (8 * i)));
+	}
+}
+
+Uint32 readUint32(const std::vector<Uint8>& packet, std::size_t offset) {
+	Uint32 value = 0;
+	for (int i = 0; i < 4; i++) {
+		value |= static_cast<Uint32>(packet[offset + i]) << (8 * i);
+	}
+	return value;
+}
+
+}
+
+LockstepSession::LockstepSession(std::unique_ptr<Transport> transport, const std::string& localPlayers, const std::string& remotePlayers,
+	unsigned int inputDelay, unsigned int rollbackTicks, Uint32 matchTag)
+: transport(std::move(transport)), inputDelay(std::min(inputDelay, static_cast<unsigned int>(Constants::LOCKSTEP_MAX_INPUT_DELAY))),
+rollbackTicks(std::min(rollbackTicks, static_cast<unsigned int>(Constants::ROLLBACK_MAX_TICKS))), matchTag(matchTag) {
+	for (char playerId : localPlayers) {
+		this->localPlayers.push_back(PlayerInputs{ playerId, std::vector<Uint8>(Constants::LOCKSTEP_INPUT_WINDOW, 0) });
+	}
+	for (char playerId : remotePlayers) {
+		PlayerInputs player{ playerId, std::vector<Uint8>(Constants::LOCKSTEP_INPUT_WINDOW, 0) };
+		player.predictions.assign(Constants::LOCKSTEP_INPUT_WINDOW, NO_PREDICTION);
+		this->remotePlayers.push_back(player);
+	}
+	//The ticks before the first sampled input are played without input by both peers
+	localTicks = this->inputDelay;
+	remoteTicks = this->inputDelay;
+	peerAck = this->inputDelay;
+}
+
+void LockstepSession::setLocalInput(char playerId, Uint8 input) {
+	for (auto& player : localPlayers) {
+		if (player.playerId == playerId) {
+			player.nextInput = input;
+		}
+	}
+}
+
+bool LockstepSession::prepareTick(unsigned int tick) {
+	currentTick = tick;
+
+	const unsigned int knownRemoteTicks = remoteTicks;
+	std::vector<Uint8> receivedPacket;
+	while (transport->receive(receivedPacket)) {
+		readPacket(receivedPacket);
+	}
+
+	//A scheduled input overwrites the one a window earlier, which must be simulated and acknowledged already
+	const unsigned int lastTick = std::min(tick + inputDelay, peerAck + Constants::LOCKSTEP_INPUT_WINDOW);
+	bool scheduled = false;
+	while (localTicks < lastTick) {
+		localTicks++;
+		for (auto& player : localPlayers) {
+			player.inputs[localTicks % Constants::LOCKSTEP_INPUT_WINDOW] = player.nextInput;
+		}
+		scheduled = true;
+	}
+
+	//Copied, the duration constructor takes a reference and the constant has no definition
+	const int resendIntervalMs = Constants::LOCKSTEP_RESEND_INTERVAL_MS;
+	const auto now = std::chrono::steady_clock::now();
+	//New remote inputs are acknowledged right away, the peer may only wait for the ack after its match ended
+	if (scheduled || remoteTicks != knownRemoteTicks || now - lastSendTime >= std::chrono::milliseconds(resendIntervalMs)) {
+		sendInputs();
+		lastSendTime = now;
+	}
+
+	return localTicks >= tick && remoteTicks + rollbackTicks >= tick;
+}
+
+Uint8 LockstepSession::getInput(unsigned int tick, char playerId) {
+	for (auto& player : localPlayers) {
+		if (player.playerId == playerId) {
+			return player.inputs[tick % Constants::LOCKSTEP_INPUT_WINDOW];
+		}
+	}
+	for (auto& player : remotePlayers) {
+		if (player.playerId == playerId) {
+			if (tick <= remoteTicks) {
+				return player.inputs[tick % Constants::LOCKSTEP_INPUT_WINDOW];
+			}
+			//Players mostly hold their keys for many ticks, the last known input is the best guess
+			const Uint8 prediction = player.inputs[remoteTicks % Constants::LOCKSTEP_INPUT_WINDOW];
+			player.predictions[tick % Constants::LOCKSTEP_INPUT_WINDOW] = prediction;
+			return prediction;
+		}
+	}
+	return 0;
+}
+
+unsigned int LockstepSession::getRollbackTick() const {
+	return rollbackTick;
+}
+
+void LockstepSession::clearRollbackTick() {
+	rollbackTick = 0;
+}
+
+bool LockstepSession::isConfirmed(unsigned int tick) const {
+	return localTicks >= tick && remoteTicks >= tick && rollbackTick == 0;
+}
+
+bool LockstepSession::isPeerConfirmed(unsigned int tick) const {
+	return peerAck >= tick;
+}
+
+bool LockstepSession::isPeerLost() const {
+	const int timeoutMs = Constants::LOCKSTEP_TIMEOUT_MS;
+	return peerConnected && std::chrono::steady_clock::now() - lastReceiveTime > std::chrono::milliseconds(timeoutMs);
+}
+
+unsigned int LockstepSession::getInputDelay() const {
+	return inputDelay;
+}
+
+unsigned int LockstepSession::getRollbackTicks() const {
+	return rollbackTicks;
+}
+
+std::size_t LockstepSession::getBytesSent() const {
+	return bytesSent;
+}
+
+Uint32 LockstepSession::getMatchTag(std::uint64_t seed, const std::string& mapFile) {
+	//FNV-1a, the tag has to be the same on every platform
+	Uint32 hash = 2166136261u;
+	for (int i = 0; i < 8; i++) {
+		hash = (hash ^ static_cast<Uint8>(seed >> (8 * i))) * 16777619u;
+	}
+	for (char c : mapFile) {
+		hash = (hash ^ static_cast<Uint8>(c)) * 16777619u;
+	}
+	return hash;
+}
+
+void LockstepSession::sendInputs() {
+	const unsigned int firstTick = peerAck + 1;
+	const unsigned int tickCount = localTicks - peerAck;
+
+	packet.clear();
+	packet.push_back(PROTOCOL_VERSION);
+	packet.push_back(static_cast<Uint8>(inputDelay));
+	writeUint32(packet, matchTag);
+	writeUint32(packet, remoteTicks);
+	writeUint32(packet, firstTick);
+	packet.push_back(static_cast<Uint8>(tickCount));
+	packet.push_back(static_cast<Uint8>(localPlayers.size()));
+	for (auto& player : localPlayers) {
+		packet.push_back(static_cast<Uint8>(player.playerId));
+		for (unsigned int tick = firstTick; tick <= localTicks; tick++) {
+			packet.push_back(player.inputs[tick % Constants::LOCKSTEP_INPUT_WINDOW]);
+		}
+	}
+	transport->send(packet);
+	bytesSent += packet.size();
+}
+
+void LockstepSession::readPacket(const std::vector<Uint8>& packet) {
+	//Truncated packets are dropped like lost ones
+	if (packet.size() < HEADER_SIZE) {
+		return;
+	}
+	if (packet[0] != PROTOCOL_VERSION || packet[1] != inputDelay || readUint32(packet, 2) != matchTag) {
+		std::ostringstream oss;
+		oss << "The peer plays a different match, the game versions, seeds, maps or input delays differ" << std::endl;
+		throw std::runtime_error(oss.str());
+	}
+	const unsigned int ack = readUint32(packet, 6);
+	const unsigned int firstTick = readUint32(packet, 10);
+	const unsigned int tickCount = packet[14];
+	const unsigned int playerCount = packet[15];
+	if (packet.size() != HEADER_SIZE + playerCount * (1 + tickCount)) {
+		return;
+	}
+	if (playerCount != remotePlayers.size()) {
+		std::ostringstream oss;
+		oss << "The peer controls " << playerCount << " players, expected " << remotePlayers.size() << std::endl;
+		throw std::runtime_error(oss.str());
+	}
+
+	peerConnected = true;
+	lastReceiveTime = std::chrono::steady_clock::now();
+	if (ack > peerAck && ack <= localTicks) {
+		peerAck = ack;
+	}
+
+	//The packet players may come in any order, the inputs of a player follow its id
+	std::vector<std::size_t> offsets(remotePlayers.size(), 0);
+	for (unsigned int i = 0; i < playerCount; i++) {
+		const std::size_t offset = HEADER_SIZE + i * (1 + tickCount);
+		const char playerId = static_cast<char>(packet[offset]);
+		auto player = std::find_if(remotePlayers.begin(), remotePlayers.end(), [playerId](const PlayerInputs& player) {
+			return player.playerId == playerId;
+		});
+		if (player == remotePlayers.end()) {
+			std::ostringstream oss;
+			oss << "The peer controls player " << playerId << ", which is not a remote player" << std::endl;
+			throw std::runtime_error(oss.str());
+		}
+		const std::size_t index = player - remotePlayers.begin();
+		if (offsets[index] != 0) {
+			return;
+		}
+		offsets[index] = offset + 1;
+	}
+
+	//Only inputs directly following the known ones are stored, inputs must not overwrite ticks not simulated yet
+	for (unsigned int i = 0; i < tickCount; i++) {
+		const unsigned int tick = firstTick + i;
+		if (tick != remoteTicks + 1 || tick >= currentTick + Constants::LOCKSTEP_INPUT_WINDOW) {
+			continue;
+		}
+		const std::size_t slot = tick % Constants::LOCKSTEP_INPUT_WINDOW;
+		for (std::size_t j = 0; j < remotePlayers.size(); j++) {
+			PlayerInputs& player = remotePlayers[j];
+			const Uint8 input = packet[offsets[j] + i];
+			player.inputs[slot] = input;
+			if (player.predictions[slot] != NO_PREDICTION && player.predictions[slot] != input && (rollbackTick == 0 || tick < rollbackTick)) {
+				rollbackTick = tick;
+			}
+			player.predictions[slot] = NO_PREDICTION;
+		}
+		remoteTicks++;
+	}
+}
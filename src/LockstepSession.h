@@ -0,0 +1,162 @@
+#pragma once
+
+#include "SDL.h"
+
+#include "Transport.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*!
+ * Keeps the inputs of the players of a network match in lockstep with a peer.
+ *
+ * Every peer simulates the whole match and only the player inputs are exchanged. The inputs of the local players
+ * are sampled once per tick and scheduled inputDelay ticks ahead, a tick is simulated once the inputs of all players
+ * for it are known, so both peers simulate the same ticks with the same inputs. A peer that is behind stalls the other.
+ *
+ * With rollback enabled the game does not wait for the inputs of the peer, it simulates up to rollbackTicks ticks ahead
+ * with predicted remote inputs, the last known input of every remote player. When a remote input arrives that differs
+ * from the prediction, getRollbackTick() reports the first mispredicted tick and the game has to restore the state
+ * before it and simulate the ticks again with the corrected inputs.
+ *
+ * The inputs are sent in packets of the following format, numbers are little endian:
+ * version (u8), input delay (u8), match tag (u32), ack (u32), first tick (u32), tick count (u8), player count (u8),
+ * then for every local player its id (u8) followed by its input for each tick.
+ * The ack is the number of ticks of peer inputs received so far, every packet repeats all inputs the peer did not
+ * acknowledge yet, so lost packets are recovered by the next one.
+ * \see Transport
+ */
+class LockstepSession {
+private:
+	/*! Inputs of a player by tick, a tick is stored at tick % Constants::LOCKSTEP_INPUT_WINDOW. */
+	struct PlayerInputs {
+		char playerId;
+		std::vector<Uint8> inputs;
+		/*! Local input sampled for the next scheduled tick, unused for remote players. */
+		Uint8 nextInput = 0;
+		/*! Remote inputs predicted for the simulated ticks that were not received yet, NO_PREDICTION for the others. */
+		std::vector<Uint8> predictions;
+	};
+
+	/*! Marks a tick without a prediction, inputs only use the lower bits. */
+	static const Uint8 NO_PREDICTION = 0xFF;
+
+	std::unique_ptr<Transport> transport;
+	std::vector<PlayerInputs> localPlayers;
+	std::vector<PlayerInputs> remotePlayers;
+	unsigned int inputDelay;
+	/*! Ticks simulated ahead of the received remote inputs, 0 waits for the inputs like plain lockstep. */
+	unsigned int rollbackTicks;
+	/*! Identifies the match, packets of peers playing another match are rejected. */
+	Uint32 matchTag;
+
+	/*! Inputs of the local players are known for ticks 1 to localTicks. */
+	unsigned int localTicks;
+	/*! Inputs of the remote players are known for ticks 1 to remoteTicks. */
+	unsigned int remoteTicks;
+	/*! Number of ticks of local inputs the peer acknowledged. */
+	unsigned int peerAck;
+	/*! The tick prepared last. */
+	unsigned int currentTick = 1;
+	/*! First tick simulated with a mispredicted input, 0 if all predictions were right. */
+	unsigned int rollbackTick = 0;
+
+	bool peerConnected = false;
+	std::chrono::steady_clock::time_point lastSendTime;
+	std::chrono::steady_clock::time_point lastReceiveTime;
+
+	std::vector<Uint8> packet;
+	std::size_t bytesSent = 0;
+public:
+	/*!
+	 * Creates a session exchanging the inputs of the players over the transport.
+	 * The first inputDelay ticks of the match are played without input on both peers.
+	 *
+	 * \param transport Connection to the peer, owned by the session.
+	 * \param localPlayers Ids of the players controlled on this peer.
+	 * \param remotePlayers Ids of the players controlled by the peer.
+	 * \param inputDelay Ticks between sampling a local input and simulating it, has to match the peer.
+	 * \param rollbackTicks Ticks the game may simulate ahead of the remote inputs, 0 disables rollback.
+	 * \param matchTag Tag of the match, see getMatchTag().
+	 */
+	LockstepSession(std::unique_ptr<Transport> transport, const std::string& localPlayers, const std::string& remotePlayers,
+		unsigned int inputDelay, unsigned int rollbackTicks, Uint32 matchTag);
+
+	LockstepSession(const LockstepSession&) = delete;
+	LockstepSession& operator= (const LockstepSession&) = delete;
+
+	/*!
+	 * Sets the input of a local player, it is used for the next tick scheduled by prepareTick().
+	 */
+	void setLocalInput(char playerId, Uint8 input);
+
+	/*!
+	 * Exchanges inputs with the peer and returns whether the tick can be simulated, when the inputs of all players
+	 * for it are known or, with rollback, when the tick is at most rollbackTicks ahead of the known remote inputs.
+	 * The current local inputs are scheduled for the ticks up to tick + inputDelay that have none yet.
+	 * Ticks have to be prepared in ascending order apart from the ticks simulated again after a rollback.
+	 *
+	 * \throws std::runtime_error if the transport fails or the peer plays a different match.
+	 */
+	bool prepareTick(unsigned int tick);
+
+	/*!
+	 * Returns the input of a player for a tick, 0 for players not in the session.
+	 * A remote input that was not received yet is predicted and the prediction is remembered,
+	 * the tick is reported by getRollbackTick() if the received input differs.
+	 */
+	Uint8 getInput(unsigned int tick, char playerId);
+
+	/*!
+	 * Returns the first simulated tick whose predicted inputs turned out wrong, 0 if there is none.
+	 * The game has to simulate it and the following ticks again, then clear it with clearRollbackTick().
+	 */
+	unsigned int getRollbackTick() const;
+
+	void clearRollbackTick();
+
+	/*!
+	 * Whether the inputs of all players up to the tick are known, so the simulation up to it is final.
+	 */
+	bool isConfirmed(unsigned int tick) const;
+
+	/*!
+	 * Whether the peer received the local inputs up to the tick, so it can confirm the tick as well.
+	 */
+	bool isPeerConfirmed(unsigned int tick) const;
+
+	/*!
+	 * Whether the peer stopped sending packets for longer than Constants::LOCKSTEP_TIMEOUT_MS.
+	 * A peer that did not connect yet is waited for indefinitely.
+	 */
+	bool isPeerLost() const;
+
+	unsigned int getInputDelay() const;
+
+	unsigned int getRollbackTicks() const;
+
+	/*!
+	 * Returns the number of bytes sent to the peer.
+	 */
+	std::size_t getBytesSent() const;
+
+	/*!
+	 * Returns a tag identifying a match from its seed and map file, peers with a different tag can't play together.
+	 */
+	static Uint32 getMatchTag(std::uint64_t seed, const std::string& mapFile);
+private:
+	/*!
+	 * Sends all inputs the peer did not acknowledge yet.
+	 */
+	void sendInputs();
+
+	/*!
+	 * Reads an input packet and stores the remote inputs following the already known ones.
+	 *
+	 * \throws std::runtime_error if the packet comes from a peer playing a different match.
+	 */
+	void readPacket(const std::vector<Uint8>& packet);
+};
@@ -0,0 +1,43 @@
+#include "LoopbackTransport.h"
+
+LoopbackTransport::LoopbackTransport(std::shared_ptr<Queue> incoming, std::shared_ptr<Queue> outgoing)
+: incoming(std::move(incoming)), outgoing(std::move(outgoing)) {
+
+}
+
+std::pair<std::unique_ptr<LoopbackTransport>, std::unique_ptr<LoopbackTransport>> LoopbackTransport::createPair() {
+	auto first = std::make_shared<Queue>();
+	auto second = std::make_shared<Queue>();
+	return std::make_pair(
+		std::unique_ptr<LoopbackTransport>(new LoopbackTransport(first, second)),
+		std::unique_ptr<LoopbackTransport>(new LoopbackTransport(second, first))
+	);
+}
+
+void LoopbackTransport::setLatency(unsigned int milliseconds) {
+	latency = std::chrono::milliseconds(milliseconds);
+}
+
+void LoopbackTransport::setPacketLoss(double probability, std::uint64_t seed) {
+	packetLoss = probability;
+	random.seed(seed, 0);
+}
+
+void LoopbackTransport::send(const std::vector<Uint8>& packet) {
+	if (packetLoss > 0.0 && random() < packetLoss * Random::max()) {
+		return;
+	}
+	std::lock_guard<std::mutex> lock(outgoing->mutex);
+	outgoing->packets.push_back(Packet{ std::chrono::steady_clock::now() + latency, packet });
+}
+
+bool LoopbackTransport::receive(std::vector<Uint8>& packet) {
+	std::lock_guard<std::mutex> lock(incoming->mutex);
+	//The latency of an end is fixed, so the packets become due in the order they were sent
+	if (incoming->packets.empty() || incoming->packets.front().deliveryTime > std::chrono::steady_clock::now()) {
+		return false;
+	}
+	packet = std::move(incoming->packets.front().data);
+	incoming->packets.pop_front();
+	return true;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Random.h"
+#include "Transport.h"
+
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+/*!
+ * A transport between two peers in the same process, used to play and test network matches without a network.
+ *
+ * The packets are queued in memory and never reordered. For testing, an end can delay the packets it sends by a fixed
+ * latency and drop a share of them, which simulates a slow and lossy network. The two ends may be used from different threads.
+ */
+class LoopbackTransport : public Transport {
+private:
+	struct Packet {
+		std::chrono::steady_clock::time_point deliveryTime;
+		std::vector<Uint8> data;
+	};
+
+	/*! Packets sent by one end and not yet received by the other. */
+	struct Queue {
+		std::mutex mutex;
+		std::deque<Packet> packets;
+	};
+
+	std::shared_ptr<Queue> incoming;
+	std::shared_ptr<Queue> outgoing;
+
+	std::chrono::milliseconds latency{0};
+	/*! Probability to drop a sent packet. */
+	double packetLoss = 0.0;
+	Random random;
+
+	LoopbackTransport(std::shared_ptr<Queue> incoming, std::shared_ptr<Queue> outgoing);
+public:
+	/*!
+	 * Creates two connected ends, the packets sent by one end are received by the other.
+	 */
+	static std::pair<std::unique_ptr<LoopbackTransport>, std::unique_ptr<LoopbackTransport>> createPair();
+
+	/*!
+	 * Delays the packets sent by this end, they can be received once the latency passed.
+	 */
+	void setLatency(unsigned int milliseconds);
+
+	/*!
+	 * Drops packets sent by this end with the given probability, decided by a generator with the given seed.
+	 */
+	void setPacketLoss(double probability, std::uint64_t seed);
+
+	void send(const std::vector<Uint8>& packet) override;
+	bool receive(std::vector<Uint8>& packet) override;
+};
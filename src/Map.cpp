@@ -4,13 +4,11 @@
 #include "Constants.h"
 #include "Game.h"
 #include "MapData.h"
-#include "EntityManager.h"
+#include "WorldSnapshot.h"
 
 #include <iostream>
 #include <sstream>
 
-#include "Utils.h"
-
 Map::Map() = default;
 
 Map::Map(const Map &map) {
@@ -25,17 +23,25 @@ Map& Map::operator=(const Map& map) {
 		this->mapTileWidth = map.mapTileWidth;
 		this->mapTileHeight = map.mapTileHeight;
 
-		fillWithEmptyPointers();
+		this->tiles = map.tiles;
+		this->wall = map.wall;
+		this->indestructible = map.indestructible;
+		this->bombermanPresent = map.bombermanPresent;
+		this->dangerMap = map.dangerMap;
+		bindTiles();
 
-		for (int y = 0; y < mapTileHeight; y++) {
-			for (int x = 0; x < mapTileWidth; x++) {
-				tiles[x][y] = std::make_shared<Tile>(Tile(*map.tiles[x][y]));
-			}
-		}
+		//The tile layer of the other map is not shared, this map renders its own
+		destroyTileLayer();
+		this->dirtyTiles.clear();
+		this->tileDirty.assign(tiles.size(), false);
 	}
 	return *this;
 }
 
+Map::~Map() {
+	destroyTileLayer();
+}
+
 void Map::generate(int pMapWidth, int pMapHeight, Game* game) {
 	mapWidth = pMapWidth;
 	mapHeight = pMapHeight;
@@ -43,14 +49,14 @@ void Map::generate(int pMapWidth, int pMapHeight, Game* game) {
 	mapTileWidth = mapWidth / tileSize;
 	mapTileHeight = mapHeight / tileSize;
 	
-	fillWithEmptyPointers();
+	fillWithEmptyTiles();
 
 	//Generating a default map
 	for (int y = 0; y < mapTileHeight; y++) {
 		for (int x = 0; x < mapTileWidth; x++) {
-			auto newTile = std::make_shared<Tile>(Tile(x * tileSize, y * tileSize));;
+			Tile* newTile = getTileAtIndexes(x, y);
 			if (!((x < 3 && y < 3) || (x > mapTileWidth-4 && y > mapTileHeight-4))) {
-				if (Utils::getRandomIntNumberInRange(0, 100) <= 80) {
+				if (game->getMapRandom().getIntInRange(0, 100) <= 80) {
 					newTile->setWall(true);
 				}
 			}
@@ -63,8 +69,6 @@ void Map::generate(int pMapWidth, int pMapHeight, Game* game) {
 				newTile->setIndestructible(true);
 				newTile->setEdgeWall(true);
 			}
-			tiles[x][y] = newTile;
-			game->entityManager->addEntity(newTile);
 		}
 	}
 
@@ -81,7 +85,7 @@ bool Map::generateFromMapData(MapData* mapData, Game* game) {
 		mapHeight = mapData->pixelHeight;
 		tileSize = mapData->pixelWidth / mapData->tileWidth;
 		
-		fillWithEmptyPointers();
+		fillWithEmptyTiles();
 		
 		//Parsing map data symbols
 		for (int y = 0; y < mapTileHeight; y++) {
@@ -104,63 +108,97 @@ bool Map::generateFromMapData(MapData* mapData, Game* game) {
 	return true;
 }
 
-void Map::render(SDL_Renderer * renderer) {
-	for (int y = 0; y < mapTileHeight; y++) {
-		for (int x = 0; x < mapTileWidth; x++) {
-			tiles[x][y]->render(renderer);
+void Map::update(Game* game) {
+	dangerMap.update(*this, game->getTick());
+}
+
+void Map::render(SpriteBatch& batch, bool showDanger) {
+	SDL_Renderer* renderer = batch.getRenderer();
+	batch.flush();
+	if (!tileLayer) {
+		tileLayer = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, mapWidth, mapHeight);
+		if (tileLayer) {
+			SDL_SetTextureBlendMode(tileLayer, SDL_BLENDMODE_NONE);
+		} else {
+			std::cerr << "Failed to create the tile layer texture! " << SDL_GetError() << std::endl;
+		}
+		tileLayerInvalid = true;
+	}
+
+	if (tileLayer) {
+		if (tileLayerInvalid || !dirtyTiles.empty()) {
+			renderTileLayer(batch);
+		}
+		const SDL_Rect mapRect{ 0, 0, mapWidth, mapHeight };
+		SDL_RenderCopy(renderer, tileLayer, NULL, &mapRect);
+	} else {
+		//Without a render target texture the tiles are rendered directly
+		for (auto& tile : tiles) {
+			tile.render(batch);
+		}
+		batch.flush();
+	}
+
+	if (showDanger) {
+		for (auto& tile : tiles) {
+			if (isDangerous(tile.getIndex()) || isBombermanPresent(tile.getIndex())) {
+				SDL_RenderDrawRect(renderer, tile.getRect());
+			}
 		}
 	}
 }
 
-Tile* Map::getTileAtCoordinates(const int x, const int y) const {
+void Map::invalidateTileLayer() {
+	tileLayerInvalid = true;
+}
+
+Tile* Map::getTileAtCoordinates(const int x, const int y) {
 	if (x < 0 || y < 0 || x >= mapWidth || y >= mapHeight) {
 		return nullptr;
 	}
-	Tile* tilePtr = tiles[x / tileSize][y / tileSize].get();
-	return tilePtr;
+	return &tiles[(y / tileSize) * mapTileWidth + x / tileSize];
 }
 
-Tile* Map::getTileAtIndexes(int x, int y) const {
+Tile* Map::getTileAtIndexes(int x, int y) {
 	if (x < 0 || y < 0 || x >= mapTileWidth || y >= mapTileHeight) {
 		return nullptr;
 	}
-	Tile* tilePtr = tiles[x][y].get();
-	return tilePtr;
+	return &tiles[y * mapTileWidth + x];
 }
 
-Tile* Map::getTileAbove(Tile * tile) const {
-	return getTileAtCoordinates(tile->getCenterX(), tile->getCenterY() - tileSize);
+Tile* Map::getTileAbove(const Tile* tile) {
+	return tile->getRow() > 0 ? &tiles[tile->getIndex() - mapTileWidth] : nullptr;
 }
 
-Tile* Map::getTileLeft(Tile * tile) const {
-	return getTileAtCoordinates(tile->getCenterX() - tileSize, tile->getCenterY());
+Tile* Map::getTileLeft(const Tile* tile) {
+	return tile->getColumn() > 0 ? &tiles[tile->getIndex() - 1] : nullptr;
 }
 
-Tile* Map::getTileRight(Tile * tile) const {
-	return getTileAtCoordinates(tile->getCenterX() + tileSize, tile->getCenterY());
+Tile* Map::getTileRight(const Tile* tile) {
+	return tile->getColumn() < mapTileWidth - 1 ? &tiles[tile->getIndex() + 1] : nullptr;
 }
 
-Tile* Map::getTileBelow(Tile * tile) const {
-	return getTileAtCoordinates(tile->getCenterX(), tile->getCenterY() + tileSize);
+Tile* Map::getTileBelow(const Tile* tile) {
+	return tile->getRow() < mapTileHeight - 1 ? &tiles[tile->getIndex() + mapTileWidth] : nullptr;
 }
 
-Tile* Map::getTileTopLeftCorner(Tile* tile) const {
-	return getTileAtCoordinates(tile->getCenterX() - tileSize, tile->getCenterY() - tileSize);
+Tile* Map::getTileTopLeftCorner(const Tile* tile) {
+	return tile->getRow() > 0 && tile->getColumn() > 0 ? &tiles[tile->getIndex() - mapTileWidth - 1] : nullptr;
 }
 
-Tile* Map::getTileBottomLeftCorner(Tile* tile) const {
-	return getTileAtCoordinates(tile->getCenterX() - tileSize, tile->getCenterY() + tileSize);
+Tile* Map::getTileBottomLeftCorner(const Tile* tile) {
+	return tile->getRow() < mapTileHeight - 1 && tile->getColumn() > 0 ? &tiles[tile->getIndex() + mapTileWidth - 1] : nullptr;
 }
 
-Tile* Map::getTileBottomRightCorner(Tile* tile) const {
-	return getTileAtCoordinates(tile->getCenterX() + tileSize, tile->getCenterY() + tileSize);
+Tile* Map::getTileBottomRightCorner(const Tile* tile) {
+	return tile->getRow() < mapTileHeight - 1 && tile->getColumn() < mapTileWidth - 1 ? &tiles[tile->getIndex() + mapTileWidth + 1] : nullptr;
 }
 
-Tile* Map::getTileTopRightCorner(Tile* tile) const {
-	return getTileAtCoordinates(tile->getCenterX() + tileSize, tile->getCenterY() - tileSize);
+Tile* Map::getTileTopRightCorner(const Tile* tile) {
+	return tile->getRow() > 0 && tile->getColumn() < mapTileWidth - 1 ? &tiles[tile->getIndex() - mapTileWidth + 1] : nullptr;
 }
 
-std::vector<Tile*> Map::getNeighbourTiles(Tile* tile) const {
+std::vector<Tile*> Map::getNeighbourTiles(const Tile* tile) {
 	std::vector<Tile*> neighbours = std::vector<Tile*>(8, nullptr);
 	neighbours[0] = getTileAbove(tile);
 	neighbours[1] = getTileTopLeftCorner(tile);
@@ -173,8 +211,14 @@ std::vector<Tile*> Map::getNeighbourTiles(Tile* tile) const {
 	return neighbours;
 }
 
-std::vector<Tile*> Map::getExistingNeighbourTiles(Tile* tile, bool ignoreCorners = false) const {
+std::vector<Tile*> Map::getExistingNeighbourTiles(const Tile* tile, bool ignoreCorners = false) {
 	std::vector<Tile*> neighbours;
+	getExistingNeighbourTiles(tile, ignoreCorners, neighbours);
+	return neighbours;
+}
+
+void Map::getExistingNeighbourTiles(const Tile* tile, bool ignoreCorners, std::vector<Tile*>& neighbours) {
+	neighbours.clear();
 	if (Tile* t = getTileAbove(tile)) neighbours.push_back(t);
 	if (Tile* t = getTileTopLeftCorner(tile)) {
 		if (!ignoreCorners) neighbours.push_back(t);
@@ -191,11 +235,16 @@ std::vector<Tile*> Map::getExistingNeighbourTiles(Tile* tile, bool ignoreCorners
 	if (Tile* t = getTileTopRightCorner(tile)) {
 		if (!ignoreCorners) neighbours.push_back(t);
 	}
-	return neighbours;
 }
 
-std::vector<Tile*> Map::getWalkableNeighbourTiles(Tile* tile, bool ignoreCorners = false) const {
+std::vector<Tile*> Map::getWalkableNeighbourTiles(const Tile* tile, bool ignoreCorners = false) {
 	std::vector<Tile*> neighbours;
+	getWalkableNeighbourTiles(tile, ignoreCorners, neighbours);
+	return neighbours;
+}
+
+void Map::getWalkableNeighbourTiles(const Tile* tile, bool ignoreCorners, std::vector<Tile*>& neighbours) {
+	neighbours.clear();
 	for (int i = 0; i < 8; i++) {
 		Tile* t = nullptr;
 		switch (i) {
@@ -208,80 +257,71 @@ std::vector<Tile*> Map::getWalkableNeighbourTiles(Tile* tile, bool ignoreCorners
 			case 6: t = getTileRight(tile);  break;
 			case 7: if (!ignoreCorners) t = getTileTopRightCorner(tile);  break;
 		}
-		if (t && t->isOverrideWalkable()) {
-			neighbours.push_back(t);
-		} else
-		if (t && !t->isWall() && !t->isDangerous() && !t->isBombermanPresent()) {
+		if (t && isWalkable(t->getIndex())) {
 			neighbours.push_back(t);
 		}
 	}
-	return neighbours;
 }
 
-const std::vector<std::vector<std::shared_ptr<Tile>>>& Map::getTiles() const {
+std::vector<Tile>& Map::getTiles() {
 	return tiles;
 }
 
+const std::vector<Tile>& Map::getTiles() const {
+	return tiles;
+}
+
+void Map::saveState(WorldSnapshot& snapshot) const {
+	snapshot.wall = wall;
+	snapshot.indestructible = indestructible;
+	snapshot.bombermanPresent = bombermanPresent;
+	snapshot.dangerMap = dangerMap;
+}
+
+void Map::restoreState(const WorldSnapshot& snapshot) {
+	//The setters mark only the tiles that differ from the snapshot as dirty
+	for (int index = 0; index < static_cast<int>(tiles.size()); index++) {
+		setWall(index, snapshot.wall[index] != 0);
+		setIndestructible(index, snapshot.indestructible[index] != 0);
+	}
+	bombermanPresent = snapshot.bombermanPresent;
+	dangerMap = snapshot.dangerMap;
+}
+
+DangerMap& Map::getDangerMap() {
+	return dangerMap;
+}
+
+const DangerMap& Map::getDangerMap() const {
+	return dangerMap;
+}
+
 void Map::parseCharacterAndLoadTile(const int x, const int y, const char c, Game* game) {
+	Tile* tile = getTileAtIndexes(x, y);
 	switch (c) {
 		case 'X':
-		{
-			auto newTile = std::make_shared<Tile>(Tile(x * tileSize, y * tileSize));;
-			newTile->setWall(true);
-			newTile->setIndestructible(true);
-			tiles[x][y] = newTile;
-			game->entityManager->addEntity(newTile);
+			tile->setWall(true);
+			tile->setIndestructible(true);
 			break;
-		}
 		case 'O':
-		{
-			auto newTile = std::make_shared<Tile>(Tile(x * tileSize, y * tileSize));;
-			newTile->setWall(true);
-			newTile->setIndestructible(true);
-			newTile->setEdgeWall(true);
-			tiles[x][y] = newTile;
-			game->entityManager->addEntity(newTile);
+			tile->setWall(true);
+			tile->setIndestructible(true);
+			tile->setEdgeWall(true);
 			break;
-		}
 		case 'o':
-		{
-			auto newTile = std::make_shared<Tile>(Tile(x * tileSize, y * tileSize));;
-			newTile->setWall(true);
-			tiles[x][y] = newTile;
-			game->entityManager->addEntity(newTile);
+			tile->setWall(true);
 			break;
-		}
 		case '-':
-		{
-			auto newTile = std::make_shared<Tile>(Tile(x * tileSize, y * tileSize));;
-			tiles[x][y] = newTile;
-			game->entityManager->addEntity(newTile);
 			break;
-		}
 		case 'c':
-		{
-			auto newTile = std::make_shared<Tile>(Tile(x * tileSize, y * tileSize));;
-			tiles[x][y] = newTile;
-			game->entityManager->addEntity(newTile);
-			game->registerComputer(newTile.get());
+			game->registerComputer(tile);
 			break;
-		}
 		case 'A':
-		{
-			auto newTile = std::make_shared<Tile>(Tile(x * tileSize, y * tileSize));;
-			tiles[x][y] = newTile;
-			game->entityManager->addEntity(newTile);
-			game->registerPlayer('A', newTile.get());
+			game->registerPlayer('A', tile);
 			break;
-		}
 		case 'B':
-		{
-			auto newTile = std::make_shared<Tile>(Tile(x * tileSize, y * tileSize));;
-			tiles[x][y] = newTile;
-			game->entityManager->addEntity(newTile);
-			game->registerPlayer('B', newTile.get());
+			game->registerPlayer('B', tile);
 			break;
-		}
 		default:
 			std::ostringstream oss;
 			oss << "Invalid map character ('" << c << "') at row:column " << x << ":" << y << std::endl;
@@ -289,8 +329,69 @@ void Map::parseCharacterAndLoadTile(const int x, const int y, const char c, Game
 	}
 }
 
-void Map::fillWithEmptyPointers() {
-	for (int i = 0; i < mapTileWidth; i++) {
-		tiles.push_back(std::vector<std::shared_ptr<Tile>>(mapTileHeight, std::shared_ptr<Tile>()));
+void Map::fillWithEmptyTiles() {
+	const int tileCount = mapTileWidth * mapTileHeight;
+	tiles.clear();
+	tiles.reserve(tileCount);
+	for (int y = 0; y < mapTileHeight; y++) {
+		for (int x = 0; x < mapTileWidth; x++) {
+			tiles.push_back(Tile(this, x, y, tileSize));
+		}
+	}
+	wall.assign(tileCount, false);
+	indestructible.assign(tileCount, false);
+	bombermanPresent.assign(tileCount, false);
+	dangerMap.reset(tileCount);
+
+	//The map dimensions can change, the tile layer is created again with the new size
+	destroyTileLayer();
+	dirtyTiles.clear();
+	tileDirty.assign(tileCount, false);
+}
+
+void Map::bindTiles() {
+	for (auto& tile : tiles) {
+		tile.setMap(this);
+	}
+}
+
+void Map::renderTileLayer(SpriteBatch& batch) {
+	SDL_Renderer* renderer = batch.getRenderer();
+	SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+	Uint8 r, g, b, a;
+	SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+	SDL_SetRenderTarget(renderer, tileLayer);
+	SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+
+	if (tileLayerInvalid) {
+		SDL_RenderClear(renderer);
+		for (auto& tile : tiles) {
+			tile.render(batch);
+		}
+	} else {
+		//The tile textures can be transparent, the old tiles are cleared before rendering the new ones over them
+		for (const int index : dirtyTiles) {
+			SDL_RenderFillRect(renderer, tiles[index].getRect());
+		}
+		for (const int index : dirtyTiles) {
+			tiles[index].render(batch);
+		}
+	}
+	batch.flush();
+	for (const int index : dirtyTiles) {
+		tileDirty[index] = false;
+	}
+	dirtyTiles.clear();
+	tileLayerInvalid = false;
+
+	SDL_SetRenderTarget(renderer, previousTarget);
+	SDL_SetRenderDrawColor(renderer, r, g, b, a);
+}
+
+void Map::destroyTileLayer() {
+	if (tileLayer) {
+		SDL_DestroyTexture(tileLayer);
+		tileLayer = nullptr;
 	}
+	tileLayerInvalid = true;
 }
\ No newline at end of file
@@ -1,21 +1,44 @@
 #pragma once
 
 #include "Tile.h"
+#include "DangerMap.h"
 
 #include <vector>
-#include <memory>
 
 struct MapData;
+struct WorldSnapshot;
 
 class EntityManager;
 
 /*!
  * Map holds and retains information about the world area in the form of a tile grid.
- * Handles the map rendering but registers tiles in the entity manager for updates.
+ * Handles the map rendering and updates of the tile state.
+ * The tiles are rendered into a cached tile layer texture, only tiles whose appearance changed are rendered again.
+ *
+ * Tiles are stored in a single row-major vector, the tile at indexes x,y is at index y * mapTileWidth + x.
+ * The frequently accessed tile state is kept in packed arrays indexed the same way,
+ * tiles only forward their getters and setters to them.
  */
 class Map {
 private:
-	std::vector<std::vector<std::shared_ptr<Tile>>> tiles;
+	std::vector<Tile> tiles;
+
+	/* Packed tile state, see the Tile getters for the meaning of each array. */
+	std::vector<unsigned char> wall;
+	std::vector<unsigned char> indestructible;
+	std::vector<unsigned char> bombermanPresent;
+
+	/*! Bomb state of the tiles shared by all AIs. */
+	DangerMap dangerMap;
+
+	/*! Cached rendering of all tiles, created on the first render. Every map owns its own texture, it is not copied. */
+	SDL_Texture* tileLayer = nullptr;
+	/*! Whether all tiles have to be rendered into the tile layer again. */
+	bool tileLayerInvalid = true;
+	/*! Indexes of tiles that changed since they were last rendered into the tile layer. */
+	std::vector<int> dirtyTiles;
+	/*! Whether a tile is listed in dirtyTiles. */
+	std::vector<unsigned char> tileDirty;
 public:
 	/* Map width in game units (pixels). */
 	int mapWidth{};
@@ -43,6 +66,8 @@ public:
 	Map(const Map &map);
 
 	Map& operator= (const Map& map);
+
+	~Map();
 	
 	/*!
 	 * Generates a default map.
@@ -57,16 +82,52 @@ public:
 	bool generateFromMapData(MapData* mapData, Game* game);
 
 	/*!
-	 * Renders the map tiles
+	 * Advances the danger map to the current tick.
+	 * Called once per tick before entities are updated.
+	 */
+	void update(Game* game);
+
+	/*!
+	 * Stores the tile state and the danger map in a snapshot.
 	 */
-	void render(SDL_Renderer* renderer);
+	void saveState(WorldSnapshot& snapshot) const;
+
+	/*!
+	 * Restores the tile state and the danger map from a snapshot of this map, tiles that changed are rendered again.
+	 */
+	void restoreState(const WorldSnapshot& snapshot);
+
+	/*!
+	 * Renders the map tiles.
+	 * Changed tiles are rendered into the tile layer first, then the whole layer is copied to the current render target.
+	 *
+	 * \param batch The sprite batch the tiles are drawn with, it is flushed before returning.
+	 * \param showDanger Whether to outline the tiles the AI considers dangerous or occupied.
+	 */
+	void render(SpriteBatch& batch, bool showDanger);
+
+	/*!
+	 * Marks a tile to be rendered into the tile layer again on the next render.
+	 * Called whenever the appearance of a tile changes.
+	 */
+	void markTileDirty(int index) {
+		if (!tileDirty[index]) {
+			tileDirty[index] = true;
+			dirtyTiles.push_back(index);
+		}
+	}
+
+	/*!
+	 * Renders all tiles into the tile layer again on the next render, used when the layer texture content was lost.
+	 */
+	void invalidateTileLayer();
 
 	/*!
 	 * Get tile that is located at game coordinates.
 	 *
 	 * \return A pointer to the tile.
 	 */
-	Tile* getTileAtCoordinates(int x, int y) const;
+	Tile* getTileAtCoordinates(int x, int y);
 
 	/*!
 	 * Get tile by its index in the tile array.
@@ -74,28 +135,39 @@ public:
 	 *
 	 * \return A pointer to the tile.
 	 */
-	Tile* getTileAtIndexes(int x, int y) const;
-	
-	Tile* getTileAbove(Tile* tile) const;
-	Tile* getTileLeft(Tile* tile) const;
-	Tile* getTileRight(Tile* tile) const;
-	Tile* getTileBelow(Tile* tile) const;
-	Tile* getTileTopLeftCorner(Tile* tile) const;
-	Tile* getTileBottomLeftCorner(Tile* tile) const;
-	Tile* getTileBottomRightCorner(Tile* tile) const;
-	Tile* getTileTopRightCorner(Tile* tile) const;
+	Tile* getTileAtIndexes(int x, int y);
+
+	/*
+	 * Neighbour lookups are resolved from the tile position in the grid.
+	 * The tile can belong to a different map with the same dimensions (e.g. the original of a copy),
+	 * the returned tile always belongs to this map.
+	 */
+	Tile* getTileAbove(const Tile* tile);
+	Tile* getTileLeft(const Tile* tile);
+	Tile* getTileRight(const Tile* tile);
+	Tile* getTileBelow(const Tile* tile);
+	Tile* getTileTopLeftCorner(const Tile* tile);
+	Tile* getTileBottomLeftCorner(const Tile* tile);
+	Tile* getTileBottomRightCorner(const Tile* tile);
+	Tile* getTileTopRightCorner(const Tile* tile);
 
 	/*!
 	 * Returns a vector containing 8 neighbour tiles starting from the tile above, continuing counter-clockwise.
 	 * Tile that do not exists are represented with a nullptr.
 	 */
-	std::vector<Tile*> getNeighbourTiles(Tile* tile) const;
+	std::vector<Tile*> getNeighbourTiles(const Tile* tile);
 
 	/*!
 	 * Returns a vector containing 0 to 8 neighbour (or 0 to 4 neighbours if ignoreCorners is true) tiles starting from the tile above, continuing counter-clockwise.
 	 * Tile that do not exist are ommitted.
 	 */
-	std::vector<Tile*> getExistingNeighbourTiles(Tile* tile, bool ignoreCorners) const;
+	std::vector<Tile*> getExistingNeighbourTiles(const Tile* tile, bool ignoreCorners);
+
+	/*!
+	 * Fills the neighbours vector with the existing neighbour tiles without allocating a new vector.
+	 * \see getExistingNeighbourTiles()
+	 */
+	void getExistingNeighbourTiles(const Tile* tile, bool ignoreCorners, std::vector<Tile*>& neighbours);
 
 	/*!
 	 * Returns a vector containing 0 to 8 neighbour (or 0 to 4 neighbours if ignoreCorners is true) tiles starting from the tile above, continuing counter-clockwise.
@@ -103,13 +175,63 @@ public:
 	 *
 	 * \see Tile::isDangerous()
 	 */
-	std::vector<Tile*> getWalkableNeighbourTiles(Tile* tile, bool ignoreCorners) const;
+	std::vector<Tile*> getWalkableNeighbourTiles(const Tile* tile, bool ignoreCorners);
+
+	/*!
+	 * Fills the neighbours vector with the walkable neighbour tiles without allocating a new vector.
+	 * \see getWalkableNeighbourTiles()
+	 */
+	void getWalkableNeighbourTiles(const Tile* tile, bool ignoreCorners, std::vector<Tile*>& neighbours);
 
 	
 	/*!
-	 * Returns a reference to the internal 2D tile vector.
+	 * Returns a reference to the internal row-major tile vector.
+	 */
+	std::vector<Tile>& getTiles();
+	const std::vector<Tile>& getTiles() const;
+
+	/*!
+	 * Returns the danger map, bombs register themselves in it when placed and when they explode.
+	 */
+	DangerMap& getDangerMap();
+	const DangerMap& getDangerMap() const;
+
+	/* Packed tile state access by tile index, kept inline as these are queried in the collision and pathfinding loops. */
+	bool isWall(int index) const { return wall[index] != 0; }
+	void setWall(int index, bool value) {
+		if (isWall(index) != value) {
+			wall[index] = value;
+			markTileDirty(index);
+		}
+	}
+	bool isIndestructible(int index) const { return indestructible[index] != 0; }
+	void setIndestructible(int index, bool value) {
+		if (isIndestructible(index) != value) {
+			indestructible[index] = value;
+			markTileDirty(index);
+		}
+	}
+	bool isBombPlaced(int index) const { return dangerMap.isBombPlaced(index); }
+	bool isBombermanPresent(int index) const { return bombermanPresent[index] != 0; }
+	void setBombermanPresent(int index, bool value) { bombermanPresent[index] = value; }
+	int getTicksToExplosion(int index) const { return dangerMap.getTicksToExplosion(index); }
+
+	/*!
+	 * Whether the tile at the index is safe to stand on.
+	 * \see Tile::isDangerous()
+	 */
+	bool isDangerous(int index) const {
+		const int ticksToExplosion = getTicksToExplosion(index);
+		return isBombPlaced(index) || (ticksToExplosion > 0 && ticksToExplosion < 64);
+	}
+
+	/*!
+	 * Whether the tile at the index can be walked through by the pathfinding algorithms.
+	 * Walkable tiles are not walls, are not dangerous and no bomberman stands on them.
 	 */
-	const std::vector<std::vector<std::shared_ptr<Tile>>>& getTiles() const;
+	bool isWalkable(int index) const {
+		return !wall[index] && !isDangerous(index) && !bombermanPresent[index];
+	}
 private:
 	/*!
 	 * Creates the appropriate tile specified by the character at the x,y coordinates.
@@ -122,7 +244,23 @@ private:
 	void parseCharacterAndLoadTile(const int x, const int y, const char c, Game* game);
 
 	/*!
-	 * Initialises tiles with empty pointers
+	 * Creates empty tiles covering the whole map.
+	 * The tile vector is never resized afterwards so tile pointers stay valid for the lifetime of the map.
+	 */
+	void fillWithEmptyTiles();
+
+	/*!
+	 * Points the tiles back to this map, required after the tiles were copied from a different map.
+	 */
+	void bindTiles();
+
+	/*!
+	 * Renders the tiles that changed into the tile layer texture.
+	 */
+	void renderTileLayer(SpriteBatch& batch);
+
+	/*!
+	 * Destroys the tile layer texture, a new one is created on the next render.
 	 */
-	void fillWithEmptyPointers();
+	void destroyTileLayer();
 };
\ No newline at end of file
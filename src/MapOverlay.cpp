@@ -0,0 +1,54 @@
+#include "MapOverlay.h"
+
+#include <algorithm>
+
+void MapOverlay::reset(Map* map) {
+	this->map = map;
+	const size_t tileCount = map->getTiles().size();
+	if (stamps.size() != tileCount) {
+		stamps.assign(tileCount, 0);
+		bombPlaced.assign(tileCount, false);
+		bombermanPresent.assign(tileCount, false);
+		ticksToExplosion.assign(tileCount, 0);
+		generation = 0;
+	}
+	generation++;
+	if (generation == 0) {
+		//The generation counter wrapped around, old stamps could match again
+		std::fill(stamps.begin(), stamps.end(), 0);
+		generation = 1;
+	}
+}
+
+Map* MapOverlay::getMap() const {
+	return map;
+}
+
+std::vector<Tile>& MapOverlay::getTiles() {
+	return map->getTiles();
+}
+
+bool MapOverlay::isDangerous(int index) const {
+	if (!isOverridden(index)) {
+		return map->isDangerous(index);
+	}
+	return bombPlaced[index] || (ticksToExplosion[index] > 0 && ticksToExplosion[index] < 64);
+}
+
+std::vector<Tile*> MapOverlay::getExistingNeighbourTiles(const Tile* tile, bool ignoreCorners) {
+	return map->getExistingNeighbourTiles(tile, ignoreCorners);
+}
+
+std::vector<Tile*> MapOverlay::getWalkableNeighbourTiles(const Tile* tile, bool ignoreCorners) {
+	std::vector<Tile*> neighbours;
+	getWalkableNeighbourTiles(tile, ignoreCorners, neighbours);
+	return neighbours;
+}
+
+void MapOverlay::getWalkableNeighbourTiles(const Tile* tile, bool ignoreCorners, std::vector<Tile*>& neighbours) {
+	//Existing neighbours are listed in the same order as the walkable neighbours of the map
+	map->getExistingNeighbourTiles(tile, ignoreCorners, neighbours);
+	neighbours.erase(std::remove_if(neighbours.begin(), neighbours.end(), [this](const Tile* t) {
+		return !isWalkable(t->getIndex());
+	}), neighbours.end());
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Map.h"
+
+#include <vector>
+
+/*!
+ * A copy-on-write view of the bomb and bomberman state of a map.
+ * Used by the AI to simulate hypothetical bombs without copying the map.
+ *
+ * Walls are always read from the map, the overridable state is read from the map
+ * until a tile is first written to. Overrides are marked with the current generation,
+ * so discarding all of them with reset() does not touch the per tile arrays.
+ * The arrays are only allocated when the map dimensions change.
+ */
+class MapOverlay {
+private:
+	Map* map = nullptr;
+
+	/*! Current generation, a tile is overridden when its stamp equals the generation. */
+	unsigned int generation = 0;
+	std::vector<unsigned int> stamps;
+
+	std::vector<unsigned char> bombPlaced;
+	std::vector<unsigned char> bombermanPresent;
+	std::vector<int> ticksToExplosion;
+public:
+	/*!
+	 * Discards all overrides and binds the overlay to a map.
+	 */
+	void reset(Map* map);
+
+	/*! The underlying map. */
+	Map* getMap() const;
+
+	/*! Tiles of the underlying map. */
+	std::vector<Tile>& getTiles();
+
+	bool isWall(int index) const { return map->isWall(index); }
+	bool isIndestructible(int index) const { return map->isIndestructible(index); }
+
+	bool isBombPlaced(int index) const { return isOverridden(index) ? bombPlaced[index] != 0 : map->isBombPlaced(index); }
+	void setBombPlaced(int index, bool value) { override(index); bombPlaced[index] = value; }
+	bool isBombermanPresent(int index) const { return isOverridden(index) ? bombermanPresent[index] != 0 : map->isBombermanPresent(index); }
+	void setBombermanPresent(int index, bool value) { override(index); bombermanPresent[index] = value; }
+	int getTicksToExplosion(int index) const { return isOverridden(index) ? ticksToExplosion[index] : map->getTicksToExplosion(index); }
+	void setTicksToExplosion(int index, int value) { override(index); ticksToExplosion[index] = value; }
+
+	/*!
+	 * Whether the tile at the index is safe to stand on, taking overrides into account.
+	 * \see Map::isDangerous()
+	 */
+	bool isDangerous(int index) const;
+
+	/*!
+	 * Whether the tile at the index is walkable, taking overrides into account.
+	 * \see Map::isWalkable()
+	 */
+	bool isWalkable(int index) const {
+		return !isWall(index) && !isDangerous(index) && !isBombermanPresent(index);
+	}
+
+	/*!
+	 * \see Map::getExistingNeighbourTiles()
+	 */
+	std::vector<Tile*> getExistingNeighbourTiles(const Tile* tile, bool ignoreCorners);
+
+	/*!
+	 * \see Map::getWalkableNeighbourTiles()
+	 */
+	std::vector<Tile*> getWalkableNeighbourTiles(const Tile* tile, bool ignoreCorners);
+
+	/*!
+	 * \see Map::getWalkableNeighbourTiles()
+	 */
+	void getWalkableNeighbourTiles(const Tile* tile, bool ignoreCorners, std::vector<Tile*>& neighbours);
+private:
+	bool isOverridden(int index) const { return stamps[index] == generation; }
+
+	/*!
+	 * Copies the map state of a tile into the overlay the first time it is written to in this generation.
+	 */
+	void override(int index) {
+		if (!isOverridden(index)) {
+			stamps[index] = generation;
+			bombPlaced[index] = map->isBombPlaced(index);
+			bombermanPresent[index] = map->isBombermanPresent(index);
+			ticksToExplosion[index] = map->getTicksToExplosion(index);
+		}
+	}
+};
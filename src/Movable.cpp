@@ -4,11 +4,12 @@
 #include "Collision.h"
 #include "Tile.h"
 #include "Utils.h"
+#include "WorldSnapshot.h"
 
 /*!
  * Creates the movable at the specified coordinates.
  */
-Movable::Movable(SDL_Texture * texture, int initialX, int initialY, int width, int height)
+Movable::Movable(const TextureRegion& texture, int initialX, int initialY, int width, int height)
 : Entity(texture, initialX, initialY, width, height) {
 	
 }
@@ -21,6 +22,12 @@ void Movable::update(Game* game) {
 		//For speeds >1 the entity moves by multiple units. To simulate how the movement would play out each 1 unit step the collision
 		//handling is executed everytime. This way if an entity has a high speed it still reacts to collision as if it was moving slowly.
 		//The collision system in general is rather rudimentary and ineffective but it should suffice for the needs of this game.
+		//Walls and other entities are probed separately so that tile corners can be recognised without a type check
+		std::vector<std::shared_ptr<Entity>> verticalCollidingWalls;
+		std::vector<std::shared_ptr<Entity>> verticalCollidingEntities;
+		std::vector<std::shared_ptr<Entity>> horizontalCollidingWalls;
+		std::vector<std::shared_ptr<Entity>> horizontalCollidingEntities;
+
 		for (int step = 0; step < speed; step++) {
 			//Resolving horizontal, vertical and diagonal collisions
 			
@@ -35,21 +42,25 @@ void Movable::update(Game* game) {
 			SDL_Rect newDiagPos = position;
 			SDL_Rect newHorizontalPos = position;
 			SDL_Rect newVerticalPos = position;
-			
-			std::vector<std::shared_ptr<Entity>> verticalCollisionCollidingEntities;
-			std::vector<std::shared_ptr<Entity>> horizontalCollisionCollidingEntities;
-			
+
+			verticalCollidingWalls.clear();
+			verticalCollidingEntities.clear();
+			horizontalCollidingWalls.clear();
+			horizontalCollidingEntities.clear();
+
 			if (movementVector.x != 0 && movementVector.y != 0) {
 				Utils::addVectorToRect(newDiagPos, movementVector);
 				diagonalCollision = Collision::checkCollision(newDiagPos, &collidingEntities, nullptr, this, game);
 			}
 			if (movementVector.x != 0) {
 				newHorizontalPos.x += movementVector.x;
-				horizontalCollision = Collision::checkCollision(newHorizontalPos, &collidingEntities, &horizontalCollisionCollidingEntities, this, game);
+				horizontalCollision = Collision::checkWallCollision(newHorizontalPos, &collidingEntities, &horizontalCollidingWalls, game);
+				horizontalCollision |= Collision::checkEntityCollision(newHorizontalPos, &collidingEntities, &horizontalCollidingEntities, this, game);
 			}
 			if (movementVector.y != 0) {
 				newVerticalPos.y += movementVector.y;
-				verticalCollision = Collision::checkCollision(newVerticalPos, &collidingEntities, &verticalCollisionCollidingEntities, this, game);
+				verticalCollision = Collision::checkWallCollision(newVerticalPos, &collidingEntities, &verticalCollidingWalls, game);
+				verticalCollision |= Collision::checkEntityCollision(newVerticalPos, &collidingEntities, &verticalCollidingEntities, this, game);
 			}
 
 
@@ -59,64 +70,66 @@ void Movable::update(Game* game) {
 			//towards the corner of the tile to make navigating grid like pathways easier.
 			//(Mainly to make it easier for the player)
 			
+			//Corner evasion only applies when the movable collides with exactly one object and that object is a wall tile
+			const size_t verticalCollisionCount = verticalCollidingWalls.size() + verticalCollidingEntities.size();
+			const size_t horizontalCollisionCount = horizontalCollidingWalls.size() + horizontalCollidingEntities.size();
+
 			bool verticalCorner = false;
 			Entity* cornerEntity = nullptr;
-			if (verticalCollisionCollidingEntities.size() == 1 && movementVector.x == 0 && horizontalCollisionCollidingEntities.size() != 1) {
-				cornerEntity = verticalCollisionCollidingEntities[0].get();
+			if (verticalCollisionCount == 1 && movementVector.x == 0 && horizontalCollisionCount != 1) {
+				cornerEntity = verticalCollidingWalls.empty() ? nullptr : verticalCollidingWalls[0].get();
 				verticalCorner = true;
 			}
-			if (horizontalCollisionCollidingEntities.size() == 1 && movementVector.y == 0 && verticalCollisionCollidingEntities.size() != 1) {
-				cornerEntity = horizontalCollisionCollidingEntities[0].get();
+			if (horizontalCollisionCount == 1 && movementVector.y == 0 && verticalCollisionCount != 1) {
+				cornerEntity = horizontalCollidingWalls.empty() ? nullptr : horizontalCollidingWalls[0].get();
 				verticalCorner = false;
 			}
 
 			if (cornerEntity) {
-				if (dynamic_cast<Tile*>(cornerEntity)) {
-					const int cornerWidth = cornerEntity->getRect()->w / 2;
-					const int cornerRemainingWidth = cornerEntity->getRect()->w - cornerWidth;
-					const int cornerHeight = cornerEntity->getRect()->h / 2;
-					const int cornerRemainingHeight = cornerEntity->getRect()->h - cornerHeight;
-
-					//Creating corner zones of the tile
-					SDL_Rect topLeftCorner{ cornerEntity->getRect()->x, cornerEntity->getRect()->y, cornerWidth, cornerHeight };
-					SDL_Rect bottomLeftCorner{ cornerEntity->getRect()->x, cornerEntity->getRect()->y + cornerRemainingHeight, cornerWidth, cornerHeight };
-					SDL_Rect bottomRightCorner{ cornerEntity->getRect()->x + cornerRemainingWidth, cornerEntity->getRect()->y + cornerRemainingHeight, cornerWidth, cornerHeight };
-					SDL_Rect topRightCorner{ cornerEntity->getRect()->x + cornerRemainingWidth, cornerEntity->getRect()->y, cornerWidth, cornerHeight };
-
-					//If the movable intersection rectangle is contained within a corner zone,
-					//an appropriate direction towards the corner is forced
-					SDL_Rect intersectionRectValue = SDL_Rect();
-					SDL_Rect* intersectionRect = &intersectionRectValue;
-					const SDL_Rect* cornerEntityRect = verticalCorner ? verticalCollisionCollidingEntities[0]->getRect() : horizontalCollisionCollidingEntities[0]->getRect();
-					SDL_Rect* newMovablePositionRect = verticalCorner ? &newVerticalPos : &newHorizontalPos;
-					if (SDL_IntersectRect(newMovablePositionRect, cornerEntityRect, intersectionRect) == SDL_TRUE) {
-						if (Utils::rectInRect(intersectionRect, &topLeftCorner)) {
-							if (verticalCorner) {
-								movementVector.x = -1;
-							} else {
-								movementVector.y = -1;
-							}
-						} else
-						if (Utils::rectInRect(intersectionRect, &bottomLeftCorner)) {
-							if (verticalCorner) {
-								movementVector.x = -1;
-							} else {
-								movementVector.y = 1;
-							}
-						} else
-						if (Utils::rectInRect(intersectionRect, &bottomRightCorner)) {
-							if (verticalCorner) {
-								movementVector.x = 1;
-							} else {
-								movementVector.y = 1;
-							}
-						} else
-						if (Utils::rectInRect(intersectionRect, &topRightCorner)) {
-							if (verticalCorner) {
-								movementVector.x = 1;
-							} else {
-								movementVector.y = -1;
-							}
+				const int cornerWidth = cornerEntity->getRect()->w / 2;
+				const int cornerRemainingWidth = cornerEntity->getRect()->w - cornerWidth;
+				const int cornerHeight = cornerEntity->getRect()->h / 2;
+				const int cornerRemainingHeight = cornerEntity->getRect()->h - cornerHeight;
+
+				//Creating corner zones of the tile
+				SDL_Rect topLeftCorner{ cornerEntity->getRect()->x, cornerEntity->getRect()->y, cornerWidth, cornerHeight };
+				SDL_Rect bottomLeftCorner{ cornerEntity->getRect()->x, cornerEntity->getRect()->y + cornerRemainingHeight, cornerWidth, cornerHeight };
+				SDL_Rect bottomRightCorner{ cornerEntity->getRect()->x + cornerRemainingWidth, cornerEntity->getRect()->y + cornerRemainingHeight, cornerWidth, cornerHeight };
+				SDL_Rect topRightCorner{ cornerEntity->getRect()->x + cornerRemainingWidth, cornerEntity->getRect()->y, cornerWidth, cornerHeight };
+
+				//If the movable intersection rectangle is contained within a corner zone,
+				//an appropriate direction towards the corner is forced
+				SDL_Rect intersectionRectValue = SDL_Rect();
+				SDL_Rect* intersectionRect = &intersectionRectValue;
+				const SDL_Rect* cornerEntityRect = cornerEntity->getRect();
+				SDL_Rect* newMovablePositionRect = verticalCorner ? &newVerticalPos : &newHorizontalPos;
+				if (SDL_IntersectRect(newMovablePositionRect, cornerEntityRect, intersectionRect) == SDL_TRUE) {
+					if (Utils::rectInRect(intersectionRect, &topLeftCorner)) {
+						if (verticalCorner) {
+							movementVector.x = -1;
+						} else {
+							movementVector.y = -1;
+						}
+					} else
+					if (Utils::rectInRect(intersectionRect, &bottomLeftCorner)) {
+						if (verticalCorner) {
+							movementVector.x = -1;
+						} else {
+							movementVector.y = 1;
+						}
+					} else
+					if (Utils::rectInRect(intersectionRect, &bottomRightCorner)) {
+						if (verticalCorner) {
+							movementVector.x = 1;
+						} else {
+							movementVector.y = 1;
+						}
+					} else
+					if (Utils::rectInRect(intersectionRect, &topRightCorner)) {
+						if (verticalCorner) {
+							movementVector.x = 1;
+						} else {
+							movementVector.y = -1;
 						}
 					}
 				}
@@ -154,6 +167,36 @@ void Movable::update(Game* game) {
 	}
 }
 
+void Movable::saveState(EntityState& state, WorldSnapshot& snapshot) const {
+	Entity::saveState(state, snapshot);
+	state.movable.movementDirection = movementDirection;
+	state.movable.speed = speed;
+	state.movable.collision = collision;
+
+	//Movables only move to positions free of walls and removed entities no longer collide, so only managed entities are stored
+	state.movable.collidingBegin = static_cast<unsigned int>(snapshot.collidingEntities.size());
+	for (auto& entity : collidingEntities) {
+		if (!entity->getHandle().isNull()) {
+			snapshot.collidingEntities.push_back(entity->getHandle());
+		}
+	}
+	state.movable.collidingCount = static_cast<unsigned int>(snapshot.collidingEntities.size()) - state.movable.collidingBegin;
+}
+
+void Movable::restoreState(const EntityState& state, const WorldSnapshot& snapshot, Game* game) {
+	Entity::restoreState(state, snapshot, game);
+	movementDirection = state.movable.movementDirection;
+	speed = state.movable.speed;
+	collision = state.movable.collision;
+
+	collidingEntities.clear();
+	for (unsigned int i = 0; i < state.movable.collidingCount; i++) {
+		if (Entity* entity = game->entityManager->getEntity(snapshot.collidingEntities[state.movable.collidingBegin + i])) {
+			collidingEntities.push_back(entity->shared_from_this());
+		}
+	}
+}
+
 SDL_Point Movable::getMovementDirection() const {
 	return movementDirection;
 }
@@ -24,10 +24,13 @@ protected:
 	/*! Entities that the entity is currently colliding with.*/
 	std::vector<std::shared_ptr<Entity>> collidingEntities;
 public:
-	Movable(SDL_Texture* texture, int initialX, int initialY, int width, int height);
+	Movable(const TextureRegion& texture, int initialX, int initialY, int width, int height);
 	
 	void update(Game* game) override;
 
+	void saveState(EntityState& state, WorldSnapshot& snapshot) const override;
+	void restoreState(const EntityState& state, const WorldSnapshot& snapshot, Game* game) override;
+
 	/*!
 	 * Returns the current movable movement direction.
 	 */
@@ -0,0 +1,163 @@
+#include "ParticleSystem.h"
+
+#include "Constants.h"
+#include "TextureManager.h"
+
+#include <algorithm>
+
+const int ParticleSystem::CAPACITY;
+const int ParticleSystem::EXPLOSION_LIFETIME;
+const int ParticleSystem::EXPLOSION_FADE_TICKS;
+const int ParticleSystem::WALL_DESTRUCTION_FRAME_DURATION;
+const int ParticleSystem::WALL_DESTRUCTION_SIZE;
+const int ParticleSystem::PATH_MARKER_LIFETIME;
+
+ParticleSystem::ParticleSystem()
+: rects(CAPACITY), angles(CAPACITY), ages(CAPACITY), lifetimes(CAPACITY), frames(CAPACITY), alphas(CAPACITY), kinds(CAPACITY) {
+
+}
+
+void ParticleSystem::addExplosion(const SDL_Rect& tileRect, ExplosionDirection direction) {
+	Kind kind = EXPLOSION_SIDE;
+	switch (direction) {
+		case UP:
+		case DOWN:
+		case LEFT:
+		case RIGHT:
+			kind = EXPLOSION_SIDE;
+			break;
+		case UP_END:
+		case DOWN_END:
+		case LEFT_END:
+		case RIGHT_END:
+			kind = EXPLOSION_END;
+			break;
+		case CENTER:
+			kind = EXPLOSION_CENTER;
+			break;
+	}
+
+	int angle = 0;
+	switch (direction) {
+		case DOWN:
+		case DOWN_END: angle = 180; break;
+		case LEFT:
+		case LEFT_END: angle = 270; break;
+		case RIGHT:
+		case RIGHT_END: angle = 90; break;
+		default:;
+	}
+
+	add(kind, tileRect, Constants::EXPLOSION_PARTICLE_SIZE, Constants::EXPLOSION_PARTICLE_SIZE, angle, EXPLOSION_LIFETIME);
+}
+
+void ParticleSystem::addWallDestruction(const SDL_Rect& tileRect) {
+	const int frameCount = std::max(1, static_cast<int>(TextureManager::wallExplosionAnimation.size()));
+	add(WALL_DESTRUCTION, tileRect, WALL_DESTRUCTION_SIZE, WALL_DESTRUCTION_SIZE, 0, frameCount * WALL_DESTRUCTION_FRAME_DURATION);
+}
+
+void ParticleSystem::addPathMarker(const SDL_Rect& tileRect) {
+	add(PATH_MARKER, tileRect, tileRect.w, tileRect.h, 0, PATH_MARKER_LIFETIME);
+}
+
+void ParticleSystem::update() {
+	int i = 0;
+	while (i < count) {
+		ages[i]++;
+		const int remaining = lifetimes[i] - ages[i];
+		if (remaining <= 0) {
+			//The last particle is moved here and is updated next
+			remove(i);
+			continue;
+		}
+
+		switch (kinds[i]) {
+			case EXPLOSION_CENTER:
+			case EXPLOSION_SIDE:
+			case EXPLOSION_END:
+				if (remaining < EXPLOSION_FADE_TICKS) {
+					alphas[i] = static_cast<Uint8>(255 * remaining / EXPLOSION_FADE_TICKS);
+				}
+				break;
+			case WALL_DESTRUCTION:
+				frames[i] = ages[i] / WALL_DESTRUCTION_FRAME_DURATION;
+				break;
+			case PATH_MARKER:
+				break;
+		}
+		i++;
+	}
+}
+
+void ParticleSystem::render(SpriteBatch& batch) const {
+	for (int i = 0; i < count; i++) {
+		if (kinds[i] != EXPLOSION_CENTER) {
+			renderParticle(i, batch);
+		}
+	}
+	for (int i = 0; i < count; i++) {
+		if (kinds[i] == EXPLOSION_CENTER) {
+			renderParticle(i, batch);
+		}
+	}
+	batch.flush();
+}
+
+void ParticleSystem::clear() {
+	count = 0;
+}
+
+void ParticleSystem::setMuted(bool muted) {
+	this->muted = muted;
+}
+
+int ParticleSystem::getCount() const {
+	return count;
+}
+
+void ParticleSystem::add(Kind kind, const SDL_Rect& centerRect, int width, int height, int angle, int lifetime) {
+	if (muted || count >= CAPACITY) {
+		return;
+	}
+	const int i = count++;
+	rects[i] = SDL_Rect{ centerRect.x + (centerRect.w - width) / 2, centerRect.y + (centerRect.h - height) / 2, width, height };
+	angles[i] = static_cast<short>(angle);
+	ages[i] = 0;
+	lifetimes[i] = lifetime;
+	frames[i] = 0;
+	alphas[i] = 255;
+	kinds[i] = kind;
+}
+
+void ParticleSystem::remove(int index) {
+	const int last = --count;
+	rects[index] = rects[last];
+	angles[index] = angles[last];
+	ages[index] = ages[last];
+	lifetimes[index] = lifetimes[last];
+	frames[index] = frames[last];
+	alphas[index] = alphas[last];
+	kinds[index] = kinds[last];
+}
+
+void ParticleSystem::renderParticle(int index, SpriteBatch& batch) const {
+	const TextureRegion& region = getRegion(kinds[index], frames[index]);
+	const SDL_Color color{ region.colorMod.r, region.colorMod.g, region.colorMod.b, alphas[index] };
+	batch.draw(region.texture, region.rect, rects[index], color, angles[index]);
+}
+
+const TextureRegion& ParticleSystem::getRegion(Kind kind, int frame) {
+	static const TextureRegion empty;
+	switch (kind) {
+		case EXPLOSION_CENTER: return TextureManager::explosionCenter;
+		case EXPLOSION_SIDE: return TextureManager::explosionSide;
+		case EXPLOSION_END: return TextureManager::explosionEnd;
+		case WALL_DESTRUCTION:
+			if (frame < static_cast<int>(TextureManager::wallExplosionAnimation.size())) {
+				return TextureManager::wallExplosionAnimation[frame];
+			}
+			return empty;
+		case PATH_MARKER: return TextureManager::defaultTexture;
+	}
+	return empty;
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "SDL.h"
+
+#include "Constants.h"
+#include "TextureAtlas.h"
+#include "SpriteBatch.h"
+
+#include <vector>
+
+/*!
+ * Manages short lived visual effects, explosions, wall destructions and the AI path markers.
+ *
+ * Particles are not entities, they do not collide and do not affect the game in any way.
+ * They are kept in a pool of fixed capacity, one array per particle attribute, allocated once
+ * when the system is created. Updating is a single loop over the arrays and a finished particle
+ * is replaced by the last one, so neither spawning nor removing particles allocates memory.
+ * When the pool is full new particles are dropped.
+ */
+class ParticleSystem {
+public:
+	/*! Maximum number of particles alive at the same time. */
+	static const int CAPACITY = 2048;
+
+	/*! Number of ticks an explosion particle is displayed for, as long as the explosion hurts. */
+	static const int EXPLOSION_LIFETIME = Constants::EXPLOSION_DURATION;
+	/*! Number of last ticks of an explosion particle during which it fades out. */
+	static const int EXPLOSION_FADE_TICKS = 8;
+	/*! Number of ticks each frame of the wall destruction animation is displayed for. */
+	static const int WALL_DESTRUCTION_FRAME_DURATION = 6;
+	static const int WALL_DESTRUCTION_SIZE = 64;
+	/*! Number of ticks a path marker is displayed for, path markers are added every tick by the computers. */
+	static const int PATH_MARKER_LIFETIME = 2;
+
+	/*!
+	 * Part of a bomb explosion, determines the texture and rotation of an explosion particle.
+	 */
+	enum ExplosionDirection {
+		UP, DOWN, LEFT, RIGHT, CENTER,
+		UP_END, DOWN_END, LEFT_END, RIGHT_END
+	};
+private:
+	enum Kind : Uint8 {
+		EXPLOSION_CENTER, EXPLOSION_SIDE, EXPLOSION_END,
+		WALL_DESTRUCTION, PATH_MARKER
+	};
+
+	/*! Number of alive particles, they occupy the beginning of the arrays. */
+	int count = 0;
+	/*! Whether new particles are ignored. */
+	bool muted = false;
+
+	std::vector<SDL_Rect> rects;
+	/*! Rotation in degrees, rotating clockwise. */
+	std::vector<short> angles;
+	/*! Number of ticks the particle was alive for. */
+	std::vector<int> ages;
+	/*! Number of ticks after which the particle is removed. */
+	std::vector<int> lifetimes;
+	/*! Current animation frame. */
+	std::vector<int> frames;
+	std::vector<Uint8> alphas;
+	std::vector<Kind> kinds;
+public:
+	ParticleSystem();
+
+	/*!
+	 * Adds an explosion particle.
+	 *
+	 * \param tileRect Rectangle of the exploding tile, the particle is centered in it.
+	 * \param direction Part of the explosion.
+	 */
+	void addExplosion(const SDL_Rect& tileRect, ExplosionDirection direction);
+
+	/*!
+	 * Adds the animation of a wall breaking apart.
+	 *
+	 * \param tileRect Rectangle of the destroyed wall, the animation is centered in it.
+	 */
+	void addWallDestruction(const SDL_Rect& tileRect);
+
+	/*!
+	 * Adds a marker of a tile on the path of a computer.
+	 *
+	 * \param tileRect Rectangle of the marked tile.
+	 */
+	void addPathMarker(const SDL_Rect& tileRect);
+
+	/*!
+	 * Advances all particles by a tick, animating them and removing the finished ones.
+	 */
+	void update();
+
+	/*!
+	 * Renders all particles, explosion centers are drawn over the other particles.
+	 * The batch is flushed before returning.
+	 *
+	 * \param batch The sprite batch.
+	 */
+	void render(SpriteBatch& batch) const;
+
+	/*!
+	 * Removes all particles.
+	 */
+	void clear();
+
+	/*!
+	 * Sets whether new particles are ignored, used while ticks that were displayed already are simulated again.
+	 */
+	void setMuted(bool muted);
+
+	/*!
+	 * Returns the number of alive particles.
+	 */
+	int getCount() const;
+private:
+	/*!
+	 * Adds a particle centered in a rectangle.
+	 */
+	void add(Kind kind, const SDL_Rect& centerRect, int width, int height, int angle, int lifetime);
+
+	/*!
+	 * Removes a particle by moving the last particle in its place.
+	 */
+	void remove(int index);
+
+	void renderParticle(int index, SpriteBatch& batch) const;
+
+	/*!
+	 * Returns the texture region of a particle kind.
+	 */
+	static const TextureRegion& getRegion(Kind kind, int frame);
+};
@@ -0,0 +1,147 @@
+#include "Pathfinder.h"
+
+#include "Utils.h"
+
+const std::vector<Tile*>& Pathfinder::findPath(Map& map, Tile* start, Tile* finish) {
+	path.clear();
+	//Only walkable tiles are ever added to the open set, an unwalkable target cannot be reached
+	//and searching for it would visit every tile reachable from the start
+	if (start != finish && !map.isWalkable(finish->getIndex())) {
+		return path;
+	}
+
+	std::vector<Tile>& tiles = map.getTiles();
+	beginSearch(tiles.size());
+	heap.clear();
+	insertionCounter = 0;
+
+	//The start tile distance is 0 and its priority is the distance between start and end tile coordinates.
+	//Using manhattan distance because it is recommended for 4 directional grids.
+	const int startIndex = start->getIndex();
+	stamps[startIndex] = generation;
+	distances[startIndex] = 0;
+	priorities[startIndex] = Utils::manhattanDistance(start->getX(), start->getY(), finish->getX(), finish->getY());
+	previous[startIndex] = -1;
+	closed[startIndex] = false;
+	heapPush(startIndex);
+
+	//Keep searching until you've run out of tiles or a path has been found
+	while (!heap.empty()) {
+		const int current = heapPop();
+		closed[current] = true;
+
+		//If the top tile is the target tile, trace back the path and end the search.
+		if (current == finish->getIndex()) {
+			for (int index = current; index != startIndex; index = previous[index]) {
+				path.push_back(&tiles[index]);
+			}
+			break;
+		}
+
+		//Get viable neighbours in 4 major directions
+		map.getWalkableNeighbourTiles(&tiles[current], true, neighbours);
+		for (Tile* neighbour : neighbours) {
+			const int index = neighbour->getIndex();
+			const bool discovered = isVisited(index);
+			//Tiles that were already expanded are skipped, this prevents looping
+			if (discovered && closed[index]) {
+				continue;
+			}
+
+			//A* priority = current chain step count + weight 1 (because the grid is uniform) + distance from the target to the current tile
+			const int distance = distances[current] + 1;
+			if (!discovered || distance < distances[index]) {
+				distances[index] = distance;
+				priorities[index] = distance + Utils::manhattanDistance(neighbour->getX(), neighbour->getY(), finish->getX(), finish->getY());
+				previous[index] = current;
+				if (discovered) {
+					//Priority only ever decreases, the tile moves towards the top of the heap.
+					//Like a newly inserted tile it is ordered after tiles with the same priority.
+					insertionOrder[index] = insertionCounter++;
+					heapSiftUp(heapPositions[index]);
+				} else {
+					stamps[index] = generation;
+					closed[index] = false;
+					heapPush(index);
+				}
+			}
+		}
+	}
+	return path;
+}
+
+void Pathfinder::beginSearch(size_t tileCount) {
+	if (stamps.size() != tileCount) {
+		stamps.assign(tileCount, 0);
+		distances.resize(tileCount);
+		priorities.resize(tileCount);
+		insertionOrder.resize(tileCount);
+		previous.resize(tileCount);
+		closed.resize(tileCount);
+		heapPositions.resize(tileCount);
+		heap.reserve(tileCount);
+		queue.reserve(tileCount);
+		generation = 0;
+	}
+	generation++;
+	if (generation == 0) {
+		//The generation counter wrapped around, old stamps could match again
+		std::fill(stamps.begin(), stamps.end(), 0);
+		generation = 1;
+	}
+}
+
+void Pathfinder::heapPush(int index) {
+	insertionOrder[index] = insertionCounter++;
+	heap.push_back(index);
+	heapPositions[index] = static_cast<int>(heap.size()) - 1;
+	heapSiftUp(heapPositions[index]);
+}
+
+int Pathfinder::heapPop() {
+	const int top = heap.front();
+	heap.front() = heap.back();
+	heapPositions[heap.front()] = 0;
+	heap.pop_back();
+	if (!heap.empty()) {
+		heapSiftDown(0);
+	}
+	return top;
+}
+
+void Pathfinder::heapSiftUp(int position) {
+	const int index = heap[position];
+	while (position > 0) {
+		const int parent = (position - 1) / 2;
+		if (!heapLess(index, heap[parent])) {
+			break;
+		}
+		heap[position] = heap[parent];
+		heapPositions[heap[position]] = position;
+		position = parent;
+	}
+	heap[position] = index;
+	heapPositions[index] = position;
+}
+
+void Pathfinder::heapSiftDown(int position) {
+	const int index = heap[position];
+	const int size = static_cast<int>(heap.size());
+	while (true) {
+		int child = position * 2 + 1;
+		if (child >= size) {
+			break;
+		}
+		if (child + 1 < size && heapLess(heap[child + 1], heap[child])) {
+			child++;
+		}
+		if (!heapLess(heap[child], index)) {
+			break;
+		}
+		heap[position] = heap[child];
+		heapPositions[heap[position]] = position;
+		position = child;
+	}
+	heap[position] = index;
+	heapPositions[index] = position;
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "Map.h"
+
+#include <vector>
+#include <algorithm>
+
+/*!
+ * Grid pathfinding over map tiles used by the bomberman AI.
+ *
+ * All search state is kept in scratch arrays indexed by tile index that are reused between searches.
+ * An entry is only valid when its stamp equals the generation of the current search,
+ * so starting a new search does not need to reset the arrays.
+ * The arrays are only reallocated when the map dimensions change, a search itself allocates nothing.
+ */
+class Pathfinder {
+private:
+	/*! Generation of the current search, see the class description. */
+	unsigned int generation = 0;
+	std::vector<unsigned int> stamps;
+
+	/*! A* path length from the start tile. */
+	std::vector<int> distances;
+	/*! A* priority of a tile, the path length plus the heuristic distance to the target. */
+	std::vector<int> priorities;
+	/*! Order in which tiles were (re)inserted into the open set, breaks priority ties first come first served. */
+	std::vector<unsigned int> insertionOrder;
+	/*! Index of the tile preceding the tile on the path. */
+	std::vector<int> previous;
+	/*! Whether the tile was already expanded by A*. */
+	std::vector<unsigned char> closed;
+	/*! Position of the tile in the open set heap. */
+	std::vector<int> heapPositions;
+
+	/*! A* open set, a binary min-heap of tile indexes. */
+	std::vector<int> heap;
+	unsigned int insertionCounter = 0;
+
+	/*! Breadth first search queue of tile indexes. */
+	std::vector<int> queue;
+
+	/*! Reused buffer for neighbour lookups. */
+	std::vector<Tile*> neighbours;
+
+	/*! The last found path. */
+	std::vector<Tile*> path;
+public:
+	/*!
+	 * Returns the shortest path between the two tiles using the A* pathfinding algorithm.
+	 *
+	 * \param map The map.
+	 * \param start Start tile
+	 * \param finish Target tile
+	 * \return A list containing a sequence of tiles forming the path. The last element of the list is the first tile of the path.
+	 * The returned list is reused and is only valid until the next search.
+	 * \see Map::getWalkableNeighbourTiles()
+	 */
+	const std::vector<Tile*>& findPath(Map& map, Tile* start, Tile* finish);
+
+	/*!
+	 * Returns the first tile that fulfills a condition found by a breadth first search algorithm
+	 * starting from the starting tile. The algorithm searches walkable tiles.
+	 *
+	 * The map can be either the Map or a MapOverlay, the condition is called with the same map and can be specified like so:
+	 * \code{.cpp}
+	 	template<typename MapView>
+	 	bool operator() (Tile* tile, MapView& map) const {
+			if (map.isWall(tile->getIndex())) {
+				return true;
+			}
+			return false;
+		}
+	 * \endcode
+	 * \param startingTile The start tile of the search.
+	 * \param map The map or map overlay.
+	 * \param targetTileCondition A condition that the tile needs to fulfill.
+	 * \param randomNumberGenerator Generator used to shuffle neighbours of each tile to eliminate direction bias.
+	 * \return The found tile or a nullptr if nothing was found.
+	 * \see Map::getWalkableNeighbourTiles()
+	 */
+	template<typename MapView, typename ConditionFunction, typename RandomNumberGenerator>
+	Tile* breadthFirstSearch(Tile* startingTile, MapView& map, ConditionFunction targetTileCondition, RandomNumberGenerator& randomNumberGenerator);
+private:
+	/*!
+	 * Starts a new search generation, resizes the scratch arrays if the number of tiles changed.
+	 */
+	void beginSearch(size_t tileCount);
+
+	bool isVisited(int index) const { return stamps[index] == generation; }
+
+	/*! Whether tile a is ordered before tile b in the open set. */
+	bool heapLess(int a, int b) const {
+		return priorities[a] < priorities[b] || (priorities[a] == priorities[b] && insertionOrder[a] < insertionOrder[b]);
+	}
+
+	void heapPush(int index);
+	int heapPop();
+	void heapSiftUp(int position);
+	void heapSiftDown(int position);
+};
+
+template<typename MapView, typename ConditionFunction, typename RandomNumberGenerator>
+Tile* Pathfinder::breadthFirstSearch(Tile* startingTile, MapView& map, ConditionFunction targetTileCondition, RandomNumberGenerator& randomNumberGenerator) {
+	std::vector<Tile>& tiles = map.getTiles();
+	beginSearch(tiles.size());
+
+	queue.clear();
+	stamps[startingTile->getIndex()] = generation;
+	queue.push_back(startingTile->getIndex());
+
+	//The queue is never popped from the front, the head index marks the next tile to process
+	for (size_t head = 0; head < queue.size(); head++) {
+		Tile* currentTile = &tiles[queue[head]];
+		if (targetTileCondition(currentTile, map)) {
+			return currentTile;
+		}
+		map.getWalkableNeighbourTiles(currentTile, true, neighbours);
+		std::shuffle(neighbours.begin(), neighbours.end(), randomNumberGenerator); //Shuffling neighbours to eliminate direction bias
+		for (auto& neighbour : neighbours) {
+			if (!isVisited(neighbour->getIndex())) {
+				stamps[neighbour->getIndex()] = generation;
+				queue.push_back(neighbour->getIndex());
+			}
+		}
+	}
+	return nullptr;
+}
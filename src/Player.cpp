@@ -1,40 +1,57 @@
 #include "Player.h"
 
 #include "Game.h"
+#include "WorldSnapshot.h"
 
 Player::Player(char playerId, int initialX, int initialY, SDL_Scancode actionKey, SDL_Scancode upKey, SDL_Scancode leftKey, SDL_Scancode downKey, SDL_Scancode rightKey)
 : Bomberman(initialX, initialY), playerId(playerId), actionKey(actionKey), upKey(upKey), downKey(downKey), leftKey(leftKey), rightKey(rightKey) {
-
+	kind = PLAYER;
 }
 
 void Player::update(Game* game) {
 	int dirX = 0;
 	int dirY = 0;
 	
-	if (inputUp) dirY -= 1;
-	if (inputDown) dirY += 1;
-	if (inputLeft) dirX -= 1;
-	if (inputRight) dirX += 1;
+	if (input & INPUT_UP) dirY -= 1;
+	if (input & INPUT_DOWN) dirY += 1;
+	if (input & INPUT_LEFT) dirX -= 1;
+	if (input & INPUT_RIGHT) dirX += 1;
 	
 	this->movementDirection.x = dirX;
 	this->movementDirection.y = dirY;
 
+	if (input & INPUT_ACTION) {
+		if (availableBombs > 0) placeDownBombOnUpdate = true;
+	}
+
 	Bomberman::update(game);
 }
 
+void Player::saveState(EntityState& state, WorldSnapshot& snapshot) const {
+	Bomberman::saveState(state, snapshot);
+	state.type = EntityState::PLAYER;
+	state.player.playerId = playerId;
+	state.player.input = input;
+}
+
+void Player::restoreState(const EntityState& state, const WorldSnapshot& snapshot, Game* game) {
+	Bomberman::restoreState(state, snapshot, game);
+	input = state.player.input;
+}
+
 void Player::handleKeyDown(SDL_KeyboardEvent* event) {
 	if (event->repeat == 0) {
 		if (event->keysym.scancode == upKey) {
-			inputUp = true;
+			input |= INPUT_UP;
 		}
 		if (event->keysym.scancode == downKey) {
-			inputDown = true;
+			input |= INPUT_DOWN;
 		}
 		if (event->keysym.scancode == leftKey) {
-			inputLeft = true;
+			input |= INPUT_LEFT;
 		}
 		if (event->keysym.scancode == rightKey) {
-			inputRight = true;
+			input |= INPUT_RIGHT;
 		}
 	}
 }
@@ -42,26 +59,51 @@ void Player::handleKeyDown(SDL_KeyboardEvent* event) {
 void Player::handleKeyUp(SDL_KeyboardEvent* event) {
 	if (event->repeat == 0) {
 		if (event->keysym.scancode == upKey) {
-			inputUp = false;
+			input &= ~INPUT_UP;
 		}
 		if (event->keysym.scancode == downKey) {
-			inputDown = false;
+			input &= ~INPUT_DOWN;
 		}
 		if (event->keysym.scancode == leftKey) {
-			inputLeft = false;
+			input &= ~INPUT_LEFT;
 		}
 		if (event->keysym.scancode == rightKey) {
-			inputRight = false;
+			input &= ~INPUT_RIGHT;
 		}
 	}
 }
 
 void Player::handleKeyHeldDown(const Uint8* keys) {
+	//The bomb is placed by the update, so that the game state only depends on the input of every tick
 	if (keys[actionKey]) {
-		if (availableBombs > 0) placeDownBombOnUpdate = true;	
+		input |= INPUT_ACTION;
+	} else {
+		input &= ~INPUT_ACTION;
 	}
 }
 
+Uint8 Player::getKeyboardInput(const Uint8* keys) const {
+	Uint8 keyboardInput = 0;
+	if (keys[upKey]) keyboardInput |= INPUT_UP;
+	if (keys[downKey]) keyboardInput |= INPUT_DOWN;
+	if (keys[leftKey]) keyboardInput |= INPUT_LEFT;
+	if (keys[rightKey]) keyboardInput |= INPUT_RIGHT;
+	if (keys[actionKey]) keyboardInput |= INPUT_ACTION;
+	return keyboardInput;
+}
+
+Uint8 Player::getInput() const {
+	return input;
+}
+
+void Player::setInput(Uint8 input) {
+	this->input = input;
+}
+
+char Player::getPlayerId() const {
+	return playerId;
+}
+
 std::string Player::getName() const {
 	return name;
 }
@@ -8,6 +8,17 @@
  * A bomberman taking input from the keyboard and representing a player in-game.
  */
 class Player : public Bomberman {
+public:
+	/*!
+	 * Bits of the player input bitmask.
+	 */
+	enum Input : Uint8 {
+		INPUT_UP = 1 << 0,
+		INPUT_DOWN = 1 << 1,
+		INPUT_LEFT = 1 << 2,
+		INPUT_RIGHT = 1 << 3,
+		INPUT_ACTION = 1 << 4
+	};
 private:
 	/*!
 	 * Character that represents the player in a map file.
@@ -25,10 +36,8 @@ private:
 	SDL_Scancode leftKey;
 	SDL_Scancode rightKey;
 
-	bool inputUp = false;
-	bool inputDown = false;
-	bool inputLeft = false;
-	bool inputRight = false;
+	/*! Held down keys as a bitmask of Input bits, applied on every update. */
+	Uint8 input = 0;
 
 public:
 	/*!
@@ -47,10 +56,36 @@ public:
 
 	void update(Game* game) override;
 
+	void saveState(EntityState& state, WorldSnapshot& snapshot) const override;
+	void restoreState(const EntityState& state, const WorldSnapshot& snapshot, Game* game) override;
+
 	void handleKeyDown(SDL_KeyboardEvent* event);
 	void handleKeyUp(SDL_KeyboardEvent* event);
 	void handleKeyHeldDown(const Uint8* keys);
 
+	/*!
+	 * Returns the input bitmask of the held down keys of the player.
+	 * \see Input
+	 */
+	Uint8 getKeyboardInput(const Uint8* keys) const;
+
+	/*!
+	 * Returns the input bitmask the player is controlled by.
+	 * \see Input
+	 */
+	Uint8 getInput() const;
+
+	/*!
+	 * Replaces the input bitmask, used to control the player from a replay.
+	 * \see Input
+	 */
+	void setInput(Uint8 input);
+
+	/*!
+	 * Returns the character that represents the player in a map file.
+	 */
+	char getPlayerId() const;
+
 	std::string getName() const;
 	
 	void setName(const std::string& name);
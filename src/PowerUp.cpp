@@ -3,10 +3,11 @@
 #include "Bomberman.h"
 #include "Constants.h"
 #include "TextureManager.h"
+#include "WorldSnapshot.h"
 
-PowerUp::PowerUp(SDL_Texture* texture, int initialX, int initialY)
+PowerUp::PowerUp(const TextureRegion& texture, int initialX, int initialY)
 : Collectable(texture, Constants::POWERUP_LIFETIME, initialX, initialY, Constants::POWERUP_SIZE, Constants::POWERUP_SIZE) {
-	
+	kind = POWER_UP;
 }
 
 void PowerUp::update(Game* game) {
@@ -16,6 +17,19 @@ void PowerUp::update(Game* game) {
 	Collectable::update(game);
 }
 
+void PowerUp::saveState(EntityState& state, WorldSnapshot& snapshot) const {
+	Collectable::saveState(state, snapshot);
+	state.collectable.negative = negative;
+}
+
+void PowerUp::restoreState(const EntityState& state, const WorldSnapshot& snapshot, Game* game) {
+	Collectable::restoreState(state, snapshot, game);
+	negative = state.collectable.negative;
+	if (ticksToVanish <= Constants::POWERUP_BLINK_LIFETIME) {
+		sprite.setEffect(Sprite::BLINKING, Constants::DEFAULT_BLINKING_EFFECT_DURATION);
+	}
+}
+
 void PowerUp::changeScore(Bomberman* bomberman, bool negative) {
 	if (negative) 
 		bomberman->addScore(-Constants::POWERUP_PICKUP_SCORE);
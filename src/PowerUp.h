@@ -13,10 +13,13 @@ private:
 	bool negative = false;
 	
 public:
-	PowerUp(SDL_Texture* texture, int initialX, int initialY);
+	PowerUp(const TextureRegion& texture, int initialX, int initialY);
 
 	void update(Game* game) override;
 
+	void saveState(EntityState& state, WorldSnapshot& snapshot) const override;
+	void restoreState(const EntityState& state, const WorldSnapshot& snapshot, Game* game) override;
+
 	bool isNegative() const;
 	void setNegative(bool negative);
 protected:
@@ -0,0 +1,189 @@
+#include "Profiler.h"
+
+#include "Entity.h"
+#include "Renderer.h"
+#include "GlyphAtlas.h"
+#include "SpriteBatch.h"
+#include "Constants.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <typeinfo>
+
+const int Profiler::HISTORY_LENGTH;
+
+Profiler::Profiler() {
+	addSection("events", true);
+	addSection("update", true);
+	addSection("map render", true);
+	addSection("entity render", true);
+	addSection("particle render", true);
+	addSection("info bar render", true);
+	addSection("ai planning", false);
+	addSection("collision", false);
+	addSection("particle update", false);
+	addSection("snapshot", false);
+	addSection("rollback", false);
+}
+
+int Profiler::getEntityTypeSection(const Entity& entity) {
+	const std::type_index type(typeid(entity));
+	auto it = entityTypeSections.find(type);
+	if (it != entityTypeSections.end()) {
+		return it->second;
+	}
+
+	//Type names are implementation defined, strip the "class " prefix (MSVC) or the name length prefix (GCC, Clang)
+	std::string name = type.name();
+	if (name.compare(0, 6, "class ") == 0) {
+		name = name.substr(6);
+	}
+	name.erase(0, name.find_first_not_of("0123456789"));
+
+	const int section = addSection("update " + name, false);
+	entityTypeSections.emplace(type, section);
+	return section;
+}
+
+void Profiler::endFrame() {
+	const size_t slot = frame % HISTORY_LENGTH;
+	for (size_t i = 0; i < sections.size(); i++) {
+		SectionData& section = sections[i];
+		section.history[slot] = static_cast<float>(section.current);
+		if (csvFile.is_open() && section.current > 0) {
+			csvFile << frame << "," << section.name << "," << section.current << "\n";
+		}
+		section.current = 0;
+	}
+	frame++;
+}
+
+bool Profiler::openCsvFile(const std::string& path) {
+	csvFile.open(path);
+	if (!csvFile.is_open()) {
+		std::cerr << "Failed to open profiler file " << path << std::endl;
+		return false;
+	}
+	csvFile << "frame,section,milliseconds\n";
+	updateEnabled();
+	return true;
+}
+
+void Profiler::toggleOverlay() {
+	overlayVisible = !overlayVisible;
+	updateEnabled();
+}
+
+bool Profiler::isOverlayVisible() const {
+	return overlayVisible;
+}
+
+Profiler::Statistics Profiler::getStatistics(int section) const {
+	Statistics statistics;
+	const int historySize = getHistorySize();
+	if (historySize == 0) {
+		return statistics;
+	}
+
+	std::vector<float> values(sections[section].history.begin(), sections[section].history.begin() + historySize);
+	double sum = 0;
+	for (const float value : values) {
+		sum += value;
+	}
+	statistics.min = *std::min_element(values.begin(), values.end());
+	statistics.average = sum / historySize;
+
+	//The p99 frame is the one that only 1% of the frames took longer than
+	const auto p99 = values.begin() + (historySize * 99) / 100;
+	std::nth_element(values.begin(), p99, values.end());
+	statistics.p99 = *p99;
+	return statistics;
+}
+
+void Profiler::renderOverlay(SpriteBatch& batch, const SDL_Rect& area, const GlyphAtlas& font, SDL_Color color) const {
+	SDL_Renderer* renderer = batch.getRenderer();
+	static const SDL_Color palette[] = {
+		{ 90, 160, 255, 255 }, { 255, 200, 60, 255 }, { 120, 220, 110, 255 }, { 240, 110, 200, 255 }, { 200, 200, 200, 255 }
+	};
+	const int paletteSize = sizeof(palette) / sizeof(palette[0]);
+	const int padding = 6;
+	const int graphHeight = 80;
+	const int lineHeight = 14;
+
+	//Only sections that were measured in the last frames are listed
+	std::vector<int> listedSections;
+	for (size_t i = 0; i < sections.size(); i++) {
+		if (getStatistics(static_cast<int>(i)).p99 > 0 || sections[i].topLevel) {
+			listedSections.push_back(static_cast<int>(i));
+		}
+	}
+
+	const SDL_Rect panel{ area.x + padding, area.y + padding, HISTORY_LENGTH + 2 * padding + 120,
+		graphHeight + 3 * padding + static_cast<int>(listedSections.size()) * lineHeight };
+	Uint8 r, g, b, a;
+	SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+	SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+	SDL_SetRenderDrawColor(renderer, 0, 0, 0, 190);
+	SDL_RenderFillRect(renderer, &panel);
+
+	//Stacked graph of the top level sections, the full height is twice the duration of a tick
+	const double tickMilliseconds = 1000.0 / Constants::TARGET_FPS;
+	const double pixelsPerMillisecond = graphHeight / (2 * tickMilliseconds);
+	const int graphLeft = panel.x + padding;
+	const int graphBottom = panel.y + padding + graphHeight;
+	const int historySize = getHistorySize();
+	for (int i = 0; i < historySize; i++) {
+		const size_t slot = (frame - historySize + i) % HISTORY_LENGTH;
+		const int x = graphLeft + HISTORY_LENGTH - historySize + i;
+		double y = graphBottom;
+		for (size_t s = 0; s < sections.size() && y > graphBottom - graphHeight; s++) {
+			if (!sections[s].topLevel) {
+				continue;
+			}
+			const double top = std::max(y - sections[s].history[slot] * pixelsPerMillisecond, static_cast<double>(graphBottom - graphHeight));
+			const SDL_Color& sectionColor = palette[s % paletteSize];
+			SDL_SetRenderDrawColor(renderer, sectionColor.r, sectionColor.g, sectionColor.b, 255);
+			SDL_RenderDrawLine(renderer, x, static_cast<int>(y), x, static_cast<int>(top));
+			y = top;
+		}
+	}
+	SDL_SetRenderDrawColor(renderer, 255, 60, 60, 255);
+	const int tickLineY = graphBottom - static_cast<int>(tickMilliseconds * pixelsPerMillisecond);
+	SDL_RenderDrawLine(renderer, graphLeft, tickLineY, graphLeft + HISTORY_LENGTH, tickLineY);
+
+	SDL_SetRenderDrawColor(renderer, r, g, b, a);
+	SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+
+	//Statistics of the listed sections
+	SDL_Rect textRect{ graphLeft, graphBottom + padding, 0, lineHeight };
+	for (const int section : listedSections) {
+		const Statistics statistics = getStatistics(section);
+		std::ostringstream line;
+		line << std::fixed << std::setprecision(2) << sections[section].name << "  min " << statistics.min
+			<< "  avg " << statistics.average << "  p99 " << statistics.p99 << " ms";
+		const SDL_Color textColor = sections[section].topLevel ? palette[section % paletteSize] : color;
+		font.renderText(line.str(), textRect, Renderer::TextAlign::TopLeft, textColor, batch);
+		textRect.y += lineHeight;
+	}
+	batch.flush();
+}
+
+int Profiler::addSection(const std::string& name, bool topLevel) {
+	SectionData section;
+	section.name = name;
+	section.topLevel = topLevel;
+	section.current = 0;
+	section.history.assign(HISTORY_LENGTH, 0);
+	sections.push_back(section);
+	return static_cast<int>(sections.size()) - 1;
+}
+
+void Profiler::updateEnabled() {
+	enabled = overlayVisible || csvFile.is_open();
+}
+
+int Profiler::getHistorySize() const {
+	return static_cast<int>(std::min<unsigned long long>(frame, HISTORY_LENGTH));
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "SDL.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <typeindex>
+#include <unordered_map>
+
+class Entity;
+class GlyphAtlas;
+class SpriteBatch;
+
+/*!
+ * Measures how long the game subsystems take in every frame.
+ *
+ * Time spent in a section is summed up over a frame by ProfileScope timers. When the frame ends the sums
+ * are added to a rolling history of the last HISTORY_LENGTH frames that provides min/avg/p99 statistics,
+ * and are optionally written to a CSV file. Sections can only be measured on the main thread.
+ * Measuring is enabled only while the overlay is shown or a CSV file is open, otherwise a timer costs a single branch.
+ */
+class Profiler {
+public:
+	/*!
+	 * Fixed sections of a frame. Sections for the updates of each entity type are added after SECTION_COUNT when first measured.
+	 */
+	enum Section {
+		EVENTS, UPDATE, MAP_RENDER, ENTITY_RENDER, PARTICLE_RENDER, INFO_BAR_RENDER,
+		AI_PLANNING, COLLISION, PARTICLE_UPDATE, SNAPSHOT, ROLLBACK,
+		SECTION_COUNT
+	};
+
+	/*! Number of frames the statistics are computed from. */
+	static const int HISTORY_LENGTH = 240;
+
+	/*! Frame time statistics of a section in milliseconds. */
+	struct Statistics {
+		double min = 0;
+		double average = 0;
+		double p99 = 0;
+	};
+
+	using Clock = std::chrono::steady_clock;
+private:
+	struct SectionData {
+		std::string name;
+		/*! Top level sections do not overlap each other and are stacked in the overlay graph. */
+		bool topLevel;
+		/*! Milliseconds measured in the current frame. */
+		double current;
+		/*! Milliseconds measured in the last frames, a ring buffer indexed by the frame number. */
+		std::vector<float> history;
+	};
+
+	std::vector<SectionData> sections;
+
+	/*! Sections of the entity types, see getEntityTypeSection(). */
+	std::unordered_map<std::type_index, int> entityTypeSections;
+
+	/*! Number of finished frames. */
+	unsigned long long frame = 0;
+
+	bool enabled = false;
+	bool overlayVisible = false;
+
+	/*! CSV file the frame times are streamed to, one "frame,section,milliseconds" row per measured section. */
+	std::ofstream csvFile;
+public:
+	Profiler();
+
+	/*! Whether the timers measure anything. */
+	bool isEnabled() const { return enabled; }
+
+	/*!
+	 * Adds time measured in a section to the current frame.
+	 */
+	void addTime(int section, Clock::duration duration) {
+		sections[section].current += std::chrono::duration<double, std::milli>(duration).count();
+	}
+
+	/*!
+	 * Returns the section measuring the updates of entities with the same type as the entity.
+	 */
+	int getEntityTypeSection(const Entity& entity);
+
+	/*!
+	 * Finishes the current frame, records the measured times and starts a new frame.
+	 */
+	void endFrame();
+
+	/*!
+	 * Opens a CSV file that the times of all following frames are written to.
+	 * \return true on success, false if the file can't be opened.
+	 */
+	bool openCsvFile(const std::string& path);
+
+	void toggleOverlay();
+	bool isOverlayVisible() const;
+
+	/*!
+	 * Returns the statistics of a section over the last HISTORY_LENGTH frames.
+	 */
+	Statistics getStatistics(int section) const;
+
+	/*!
+	 * Draws a graph of the top level section times of the last frames and the statistics of all sections.
+	 *
+	 * \param batch The sprite batch the text is drawn with, it is flushed before returning.
+	 * \param area The area the overlay is drawn into.
+	 * \param font Glyphs of the statistics text font.
+	 * \param color Color of the statistics text.
+	 */
+	void renderOverlay(SpriteBatch& batch, const SDL_Rect& area, const GlyphAtlas& font, SDL_Color color) const;
+private:
+	int addSection(const std::string& name, bool topLevel);
+
+	void updateEnabled();
+
+	/*!
+	 * Returns the number of frames in the history.
+	 */
+	int getHistorySize() const;
+};
+
+/*!
+ * Measures the time from its construction to its destruction and adds it to a profiler section.
+ * \code{.cpp}
+	{
+		ProfileScope scope(game->getProfiler(), Profiler::COLLISION);
+		//Measured code
+	}
+ * \endcode
+ */
+class ProfileScope {
+private:
+	Profiler* profiler;
+	int section;
+	Profiler::Clock::time_point start;
+public:
+	/*!
+	 * \param profiler The profiler, can be a nullptr in which case nothing is measured.
+	 * \param section The measured section.
+	 */
+	ProfileScope(Profiler* profiler, int section)
+	: profiler(profiler && profiler->isEnabled() ? profiler : nullptr), section(section) {
+		if (this->profiler) {
+			start = Profiler::Clock::now();
+		}
+	}
+
+	~ProfileScope() {
+		if (profiler) {
+			profiler->addTime(section, Profiler::Clock::now() - start);
+		}
+	}
+
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator= (const ProfileScope&) = delete;
+};
@@ -0,0 +1,56 @@
+#include "Random.h"
+
+#include <random>
+#include <chrono>
+#include <utility>
+
+Random::Random() : Random(0, 0) {
+
+}
+
+Random::Random(std::uint64_t seed, std::uint64_t stream) {
+	this->seed(seed, stream);
+}
+
+void Random::seed(std::uint64_t seed, std::uint64_t stream) {
+	//Initialisation sequence of the reference PCG32 implementation
+	state = 0;
+	increment = (stream << 1u) | 1u;
+	(*this)();
+	state += seed;
+	(*this)();
+}
+
+Random::result_type Random::operator()() {
+	const std::uint64_t oldState = state;
+	state = oldState * 6364136223846793005ULL + increment;
+	const std::uint32_t xorShifted = static_cast<std::uint32_t>(((oldState >> 18u) ^ oldState) >> 27u);
+	const std::uint32_t rotation = static_cast<std::uint32_t>(oldState >> 59u);
+	return (xorShifted >> rotation) | (xorShifted << ((-rotation) & 31u));
+}
+
+int Random::getIntInRange(int min, int max) {
+	if (min > max) {
+		std::swap(min, max);
+	}
+	const std::uint32_t range = static_cast<std::uint32_t>(static_cast<std::int64_t>(max) - min + 1);
+	if (range == 0) {
+		//The range spans all 32 bit numbers
+		return static_cast<int>(static_cast<std::int64_t>(min) + (*this)());
+	}
+
+	//Rejecting the lowest numbers that would make some results more likely than others
+	const std::uint32_t threshold = (0u - range) % range;
+	std::uint32_t number = (*this)();
+	while (number < threshold) {
+		number = (*this)();
+	}
+	return static_cast<int>(static_cast<std::int64_t>(min) + number % range);
+}
+
+std::uint64_t Random::generateSeed() {
+	std::random_device device;
+	const std::uint64_t deviceBits = (static_cast<std::uint64_t>(device()) << 32u) | device();
+	const std::uint64_t timeBits = static_cast<std::uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+	return deviceBits ^ timeBits;
+}
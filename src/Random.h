@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+
+/*!
+ * A seedable pseudo-random number generator (PCG32) with independent streams.
+ *
+ * Generators with the same seed and different streams produce unrelated sequences,
+ * so every part of the game draws from its own stream and a match can be reproduced from a single seed.
+ * Satisfies the standard UniformRandomBitGenerator requirements and can be used with std::shuffle.
+ */
+class Random {
+public:
+	using result_type = std::uint32_t;
+
+	/* Streams of the game subsystems. Computer n uses the stream COMPUTER_STREAMS + n. */
+	static const std::uint64_t MAP_STREAM = 1;
+	static const std::uint64_t POWER_UP_STREAM = 2;
+	static const std::uint64_t COMPUTER_STREAMS = 16;
+private:
+	std::uint64_t state = 0;
+	std::uint64_t increment = 1;
+public:
+	/*!
+	 * Creates a generator with seed 0 on stream 0.
+	 */
+	Random();
+
+	Random(std::uint64_t seed, std::uint64_t stream);
+
+	/*!
+	 * Restarts the generator with a seed on a stream.
+	 */
+	void seed(std::uint64_t seed, std::uint64_t stream);
+
+	/*!
+	 * Returns the next 32 bit number.
+	 */
+	result_type operator()();
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return UINT32_MAX; }
+
+	/*!
+	 * Returns a uniformly distributed number in the specified inclusive number range.
+	 * If min is greater than max, min and max are switched.
+	 */
+	int getIntInRange(int min, int max);
+
+	/*!
+	 * Returns a seed that differs between program runs.
+	 */
+	static std::uint64_t generateSeed();
+};
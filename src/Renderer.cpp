@@ -1,20 +1,8 @@
 #include "Renderer.h"
 
-#include "TextureManager.h"
-
-void Renderer::renderText(std::string text, SDL_Rect& targetRect, TextAlign textAlign, TTF_Font* font, SDL_Color color, SDL_Renderer* renderer) {
-	const char* cText = text.c_str();
-	SDL_Surface* textSurface = TTF_RenderText_Solid(font, cText, color);
-	SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-
-	int textWidth = 0;
-	int textHeight = 0;
-	TTF_SizeText(font, cText, &textWidth, &textHeight);
-
+SDL_Rect Renderer::alignText(const SDL_Rect& targetRect, int textWidth, int textHeight, TextAlign textAlign) {
 	int textureX;
 	int textureY;
-	const int textureWidth = textWidth;
-	const int textureHeight = textHeight;
 	
 	switch (textAlign) {
 		case TopLeft:
@@ -39,13 +27,9 @@ void Renderer::renderText(std::string text, SDL_Rect& targetRect, TextAlign text
 			break;
 	}
 	
-	SDL_Rect textTextureRect{ textureX, textureY, textureWidth, textureHeight };
-	SDL_RenderCopy(renderer, textTexture, NULL, &textTextureRect);
-
-	SDL_FreeSurface(textSurface);
-	SDL_DestroyTexture(textTexture);
+	return SDL_Rect{ textureX, textureY, textWidth, textHeight };
 }
 
-void Renderer::renderTexture(SDL_Texture* texture, SDL_Rect& rect, SDL_Renderer* renderer) {
-	SDL_RenderCopy(renderer, texture, NULL, &rect);
+void Renderer::renderTexture(const TextureRegion& texture, const SDL_Rect& rect, SpriteBatch& batch) {
+	batch.draw(texture.texture, texture.rect, rect, texture.colorMod);
 }
@@ -1,12 +1,15 @@
 #pragma once
 
 #include <SDL_render.h>
-#include <SDL_ttf.h>
+
+#include "TextureAtlas.h"
+#include "SpriteBatch.h"
 
 #include <string>
 
 /*!
  * Utility class for static helper render functions.
+ * Text is rendered with a GlyphAtlas or a TextCache.
  */
 class Renderer {
 public:
@@ -21,24 +24,22 @@ public:
 	};
 
 	/*!
-	 * Renders aligned text.
+	 * Returns the rectangle of a text of the specified size aligned in a target rectangle.
 	 * 
-	 * \param text The text content.
 	 * \param targetRect Destination rectangle, width and height may be optional based on alignment.
+	 * \param textWidth Width of the text.
+	 * \param textHeight Height of the text.
 	 * \param textAlign Text alignment.
-	 * \param font The font of the text.
-	 * \param color Color of the text.
-	 * \param renderer The renderer.
 	 * \see TextAlign
 	 */
-	static void renderText(std::string text, SDL_Rect& targetRect, TextAlign textAlign,TTF_Font* font, SDL_Color color, SDL_Renderer* renderer);
+	static SDL_Rect alignText(const SDL_Rect& targetRect, int textWidth, int textHeight, TextAlign textAlign);
 
 	/*!
-	 * Renders a texture.
+	 * Renders a texture region with its colour modulation.
 	 * 
-	 * \param texture The texture to render.
+	 * \param texture The texture region to render.
 	 * \param rect Position and dimensions of the texture.
-	 * \param renderer The renderer.
+	 * \param batch The sprite batch the texture is drawn with.
 	 */
-	static void renderTexture(SDL_Texture* texture, SDL_Rect& rect, SDL_Renderer* renderer);
-};
+	static void renderTexture(const TextureRegion& texture, const SDL_Rect& rect, SpriteBatch& batch);
+};
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include "Replay.h"
+
+#include "FileUtils.h"
+
+#include <sstream>
+#include <stdexcept>
+
+void Replay::load(const char* path) {
+	std::string content = FileUtils::loadStringFromFile(path);
+	std::istringstream contentStream(content);
+	std::string line;
+	int lineNumber = 0;
+	while (std::getline(contentStream, line)) {
+		lineNumber++;
+		if (line.empty()) {
+			continue;
+		}
+		const size_t separator = line.find('=');
+		if (separator == std::string::npos) {
+			std::ostringstream oss;
+			oss << "Failed to parse replay line " << lineNumber << std::endl;
+			throw std::runtime_error(oss.str());
+		}
+		loadEntry(line.substr(0, separator), line.substr(separator + 1));
+	}
+}
+
+void Replay::save(const char* path) const {
+	std::ostringstream oss;
+	oss << "seed=" << seed << std::endl;
+	if (!mapFile.empty()) {
+		oss << "map=" << mapFile << std::endl;
+	}
+	for (auto& playerName : playerNames) {
+		oss << playerName.first << "=" << playerName.second << std::endl;
+	}
+	oss << "length=" << length << std::endl;
+	for (auto& change : inputChanges) {
+		oss << "input=" << change.tick << " " << change.playerId << " " << static_cast<int>(change.input) << std::endl;
+	}
+	for (auto& line : outcome) {
+		oss << "outcome=" << line << std::endl;
+	}
+	std::string text = oss.str();
+	FileUtils::writeStringToFile(text, path);
+}
+
+void Replay::loadEntry(const std::string& key, const std::string& value) {
+	try {
+		if (key == "seed") {
+			seed = std::stoull(value);
+		} else
+		if (key == "map") {
+			mapFile = value;
+		} else
+		if (key == "A" || key == "B") {
+			playerNames[key[0]] = value;
+		} else
+		if (key == "length") {
+			length = static_cast<unsigned int>(std::stoul(value));
+		} else
+		if (key == "input") {
+			std::istringstream valueStream(value);
+			unsigned int tick;
+			char playerId;
+			int input;
+			if (!(valueStream >> tick >> playerId >> input) || input < 0 || input > 255) {
+				throw std::invalid_argument(value);
+			}
+			inputChanges.push_back(InputChange{ tick, playerId, static_cast<Uint8>(input) });
+		} else
+		if (key == "outcome") {
+			outcome.push_back(value);
+		}
+	} catch (const std::logic_error&) {
+		std::ostringstream oss;
+		oss << "Invalid replay " << key << " value " << value << std::endl;
+		throw std::runtime_error(oss.str());
+	}
+}
+
+void Replay::recordInput(unsigned int tick, char playerId, Uint8 input) {
+	auto lastInput = lastInputs.find(playerId);
+	if (lastInput == lastInputs.end() || lastInput->second != input) {
+		//The input of a player starts as 0, the first change is only recorded if it differs from it
+		if (lastInput != lastInputs.end() || input != 0) {
+			inputChanges.push_back(InputChange{ tick, playerId, input });
+		}
+		lastInputs[playerId] = input;
+	}
+}
+
+const std::vector<Replay::InputChange>& Replay::getInputChanges() const {
+	return inputChanges;
+}
+
+std::uint64_t Replay::getSeed() const {
+	return seed;
+}
+
+void Replay::setSeed(std::uint64_t seed) {
+	this->seed = seed;
+}
+
+const std::string& Replay::getMapFile() const {
+	return mapFile;
+}
+
+void Replay::setMapFile(const std::string& mapFile) {
+	this->mapFile = mapFile;
+}
+
+const std::map<char, std::string>& Replay::getPlayerNames() const {
+	return playerNames;
+}
+
+void Replay::setPlayerNames(const std::map<char, std::string>& playerNames) {
+	this->playerNames = playerNames;
+}
+
+unsigned int Replay::getLength() const {
+	return length;
+}
+
+void Replay::setLength(unsigned int length) {
+	this->length = length;
+}
+
+const std::vector<std::string>& Replay::getOutcome() const {
+	return outcome;
+}
+
+void Replay::setOutcome(const std::vector<std::string>& outcome) {
+	this->outcome = outcome;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "SDL.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/*!
+ * A recorded match, everything needed to simulate the match again.
+ *
+ * A match is fully determined by its seed, map and the inputs of the players, so a replay stores
+ * only those and the changes of the player inputs with the tick they happened on.
+ * The outcome of the recorded match is stored as well so that a replayed match can be compared with it.
+ *
+ * Replays are text files with the following format on each line:
+ * key=value
+ * The keys are seed, map, player names (A, B), length (number of ticks), input ("tick playerId input")
+ * and outcome (a line of the match summary).
+ */
+class Replay {
+public:
+	/*!
+	 * A change of the input of a player.
+	 */
+	struct InputChange {
+		/*! Tick the input is used from. */
+		unsigned int tick;
+		char playerId;
+		/*! Input bitmask, see Player::Input. */
+		Uint8 input;
+	};
+private:
+	std::uint64_t seed = 0;
+	/*! The map file of the match, empty for the generated map. */
+	std::string mapFile;
+	std::map<char, std::string> playerNames;
+
+	/*! Number of ticks of the match. */
+	unsigned int length = 0;
+
+	/*! Input changes in the order of ticks. */
+	std::vector<InputChange> inputChanges;
+
+	/*! Last recorded input of every player, only changes are recorded. */
+	std::map<char, Uint8> lastInputs;
+
+	/*! Lines of the summary of the recorded match. */
+	std::vector<std::string> outcome;
+public:
+	Replay() = default;
+
+	/*!
+	 * Loads a replay from a file.
+	 *
+	 * \param path Path to the replay file.
+	 * \throws std::runtime_error
+	 */
+	void load(const char* path);
+
+	/*!
+	 * Saves the replay to a file.
+	 *
+	 * \param path Path to the replay file.
+	 * \throws std::runtime_error
+	 */
+	void save(const char* path) const;
+
+	/*!
+	 * Records the input of a player on a tick, the input is only stored if it changed.
+	 * Ticks have to be recorded in ascending order.
+	 */
+	void recordInput(unsigned int tick, char playerId, Uint8 input);
+
+	const std::vector<InputChange>& getInputChanges() const;
+
+	std::uint64_t getSeed() const;
+	void setSeed(std::uint64_t seed);
+
+	const std::string& getMapFile() const;
+	void setMapFile(const std::string& mapFile);
+
+	const std::map<char, std::string>& getPlayerNames() const;
+	void setPlayerNames(const std::map<char, std::string>& playerNames);
+
+	unsigned int getLength() const;
+	void setLength(unsigned int length);
+
+	const std::vector<std::string>& getOutcome() const;
+	void setOutcome(const std::vector<std::string>& outcome);
+private:
+	/*!
+	 * Sets a replay value from a key value pair.
+	 *
+	 * \throws std::runtime_error
+	 */
+	void loadEntry(const std::string& key, const std::string& value);
+};
@@ -0,0 +1,112 @@
+#include "SpatialGrid.h"
+
+#include "Entity.h"
+
+#include <algorithm>
+
+SpatialGrid::SpatialGrid(int areaWidth, int areaHeight, int cellSize)
+: cellSize(cellSize),
+gridWidth(std::max(1, (areaWidth + cellSize - 1) / cellSize)),
+gridHeight(std::max(1, (areaHeight + cellSize - 1) / cellSize)),
+cells(gridWidth * gridHeight) {
+	
+}
+
+void SpatialGrid::insert(Entity* entity) {
+	SpatialGridEntry& entry = entity->spatialGridEntry;
+	if (entry.grid) {
+		entry.grid->remove(entity);
+	}
+	entry.grid = this;
+	entry.sequence = nextSequence++;
+	getCellRange(*entity->getRect(), entry.minCellX, entry.minCellY, entry.maxCellX, entry.maxCellY);
+	addToCells(entity, entry.minCellX, entry.minCellY, entry.maxCellX, entry.maxCellY);
+}
+
+void SpatialGrid::remove(Entity* entity) {
+	SpatialGridEntry& entry = entity->spatialGridEntry;
+	if (entry.grid == this) {
+		removeFromCells(entity, entry.minCellX, entry.minCellY, entry.maxCellX, entry.maxCellY);
+		entry.grid = nullptr;
+	}
+}
+
+void SpatialGrid::update(Entity* entity) {
+	SpatialGridEntry& entry = entity->spatialGridEntry;
+	int minCellX, minCellY, maxCellX, maxCellY;
+	getCellRange(*entity->getRect(), minCellX, minCellY, maxCellX, maxCellY);
+
+	//Most movement happens within the same cells
+	if (minCellX == entry.minCellX && minCellY == entry.minCellY && maxCellX == entry.maxCellX && maxCellY == entry.maxCellY) {
+		return;
+	}
+
+	removeFromCells(entity, entry.minCellX, entry.minCellY, entry.maxCellX, entry.maxCellY);
+	entry.minCellX = minCellX;
+	entry.minCellY = minCellY;
+	entry.maxCellX = maxCellX;
+	entry.maxCellY = maxCellY;
+	addToCells(entity, minCellX, minCellY, maxCellX, maxCellY);
+}
+
+void SpatialGrid::query(const SDL_Rect& rect, std::vector<Entity*>& result) {
+	result.clear();
+	if (rect.w <= 0 || rect.h <= 0) {
+		return;
+	}
+
+	int minCellX, minCellY, maxCellX, maxCellY;
+	getCellRange(rect, minCellX, minCellY, maxCellX, maxCellY);
+
+	queryStamp++;
+	for (int y = minCellY; y <= maxCellY; y++) {
+		for (int x = minCellX; x <= maxCellX; x++) {
+			for (Entity* entity : cells[y * gridWidth + x]) {
+				//Entities spanning multiple cells are only tested once
+				if (entity->spatialGridEntry.queryStamp != queryStamp) {
+					entity->spatialGridEntry.queryStamp = queryStamp;
+					if (SDL_HasIntersection(&rect, entity->getRect())) {
+						result.push_back(entity);
+					}
+				}
+			}
+		}
+	}
+
+	//Keeping the insertion order makes the results identical to a linear scan of all entities
+	std::sort(result.begin(), result.end(), [](const Entity* e1, const Entity* e2) {
+		return e1->spatialGridEntry.sequence < e2->spatialGridEntry.sequence;
+	});
+}
+
+void SpatialGrid::getCellRange(const SDL_Rect& rect, int& minCellX, int& minCellY, int& maxCellX, int& maxCellY) const {
+	//Coordinates outside of the grid area are clamped to the border cells
+	const int right = rect.x + std::max(rect.w, 1) - 1;
+	const int bottom = rect.y + std::max(rect.h, 1) - 1;
+	minCellX = std::min(std::max(rect.x / cellSize, 0), gridWidth - 1);
+	minCellY = std::min(std::max(rect.y / cellSize, 0), gridHeight - 1);
+	maxCellX = std::min(std::max(right / cellSize, 0), gridWidth - 1);
+	maxCellY = std::min(std::max(bottom / cellSize, 0), gridHeight - 1);
+}
+
+void SpatialGrid::addToCells(Entity* entity, int minCellX, int minCellY, int maxCellX, int maxCellY) {
+	for (int y = minCellY; y <= maxCellY; y++) {
+		for (int x = minCellX; x <= maxCellX; x++) {
+			cells[y * gridWidth + x].push_back(entity);
+		}
+	}
+}
+
+void SpatialGrid::removeFromCells(Entity* entity, int minCellX, int minCellY, int maxCellX, int maxCellY) {
+	for (int y = minCellY; y <= maxCellY; y++) {
+		for (int x = minCellX; x <= maxCellX; x++) {
+			std::vector<Entity*>& cell = cells[y * gridWidth + x];
+			auto itr = std::find(cell.begin(), cell.end(), entity);
+			if (itr != cell.end()) {
+				//Order within a cell doesn't matter, query results are sorted
+				*itr = cell.back();
+				cell.pop_back();
+			}
+		}
+	}
+}
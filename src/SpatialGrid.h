@@ -0,0 +1,95 @@
+#pragma once
+
+#include "SDL.h"
+
+#include <vector>
+
+class Entity;
+class SpatialGrid;
+
+/*!
+ * Registration data of an entity in a SpatialGrid.
+ * Copies of an entity are not registered in the grid of the original entity,
+ * so copying an entry creates an unregistered one.
+ */
+struct SpatialGridEntry {
+	/*! The grid the entity is registered in, nullptr if not registered. */
+	SpatialGrid* grid = nullptr;
+
+	/*! Range of grid cells the entity rect currently overlaps. */
+	int minCellX = 0;
+	int minCellY = 0;
+	int maxCellX = -1;
+	int maxCellY = -1;
+
+	/*! Order in which the entity was inserted into the grid. Query results are sorted by it. */
+	unsigned int sequence = 0;
+
+	/*! Stamp of the last query that visited the entity. Used to skip entities spanning multiple cells. */
+	unsigned int queryStamp = 0;
+
+	SpatialGridEntry() = default;
+	SpatialGridEntry(const SpatialGridEntry&) {}
+	SpatialGridEntry& operator=(const SpatialGridEntry&) { return *this; }
+};
+
+/*!
+ * A uniform grid of tile sized cells indexing entities by the area their rect overlaps.
+ * Used as a collision broadphase so that a query only visits entities in the cells overlapping the query rect.
+ * Entities outside of the grid area are kept in the border cells.
+ */
+class SpatialGrid {
+private:
+	int cellSize;
+	/*! Number of cells on the X axis. */
+	int gridWidth;
+	/*! Number of cells on the Y axis. */
+	int gridHeight;
+
+	/*! Entities of each cell, cells are stored row by row. */
+	std::vector<std::vector<Entity*>> cells;
+
+	unsigned int nextSequence = 0;
+	unsigned int queryStamp = 0;
+public:
+	/*!
+	 * Creates a grid covering an area.
+	 *
+	 * \param areaWidth Width of the area in game units (pixels).
+	 * \param areaHeight Height of the area in game units (pixels).
+	 * \param cellSize Width and height of a single cell.
+	 */
+	SpatialGrid(int areaWidth, int areaHeight, int cellSize);
+
+	/*!
+	 * Registers the entity in the grid. The entity keeps the grid updated when it moves.
+	 */
+	void insert(Entity* entity);
+
+	/*!
+	 * Unregisters the entity from the grid.
+	 */
+	void remove(Entity* entity);
+
+	/*!
+	 * Moves the entity to the cells its current rect overlaps. Called by entities when their position changes.
+	 */
+	void update(Entity* entity);
+
+	/*!
+	 * Finds all registered entities whose rect intersects the given rect.
+	 * The result is ordered by the order in which the entities were inserted into the grid.
+	 *
+	 * \param rect The query rect.
+	 * \param result Vector that gets cleared and filled with the intersecting entities.
+	 */
+	void query(const SDL_Rect& rect, std::vector<Entity*>& result);
+private:
+	/*!
+	 * Calculates the clamped range of cells a rect overlaps.
+	 */
+	void getCellRange(const SDL_Rect& rect, int& minCellX, int& minCellY, int& maxCellX, int& maxCellY) const;
+
+	void addToCells(Entity* entity, int minCellX, int minCellY, int maxCellX, int maxCellY);
+	void removeFromCells(Entity* entity, int minCellX, int minCellY, int maxCellX, int maxCellY);
+};
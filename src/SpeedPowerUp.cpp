@@ -4,6 +4,7 @@
 #include "TextureManager.h"
 #include "Bomberman.h"
 #include "EntityManager.h"
+#include "WorldSnapshot.h"
 
 #include <iostream>
 
@@ -11,13 +12,18 @@ SpeedPowerUp::SpeedPowerUp(int initialX, int initialY)
 	: PowerUp(TextureManager::speedPowerUp, initialX, initialY) {
 }
 
+void SpeedPowerUp::saveState(EntityState& state, WorldSnapshot& snapshot) const {
+	PowerUp::saveState(state, snapshot);
+	state.type = EntityState::SPEED_POWER_UP;
+}
+
 void SpeedPowerUp::applyEffects(Game * game) {
 	for (auto& entity : potentialCollectors) {
-		Entity* entityPtr = entity.get();
-		if (Bomberman* bomberman = dynamic_cast<Bomberman*>(entityPtr)) {
+		if (entity->isBomberman()) {
+			Bomberman* bomberman = static_cast<Bomberman*>(entity.get());
 			bomberman->setSpeed(bomberman->getSpeed() + 1);
 			changeScore(bomberman);
-			if (Game::debug) std::cout << game->getTickString() << "Bomberman picked up SpeedPowerUp" << std::endl;
+			if (game->isDebug()) game->getLog() << game->getTickString() << "Bomberman picked up SpeedPowerUp" << std::endl;
 			game->entityManager->removeEntity(this);
 		}
 	}
@@ -12,6 +12,8 @@ public:
 	 */
 	SpeedPowerUp(int initialX, int initialY);
 
+	void saveState(EntityState& state, WorldSnapshot& snapshot) const override;
+
 protected:
 	void applyEffects(Game* game) override;
 };
\ No newline at end of file
@@ -4,11 +4,9 @@
 #include "Tween.h"
 #include "Utils.h"
 
-Sprite::Sprite(SDL_Texture* texture) : activeTexture(texture) {
-	textureCoordinates = Utils::createSDLRect(0, 0, 0, 0);
-	if (texture) {
-		SDL_QueryTexture(texture, NULL, NULL, &textureCoordinates.w, &textureCoordinates.h);
-	}
+Sprite::Sprite(const TextureRegion& texture)
+: textureCoordinates(texture.rect), activeTexture(texture.texture), colorMod(texture.colorMod) {
+
 }
 
 void Sprite::update(unsigned int tick) {
@@ -25,7 +23,7 @@ void Sprite::update(unsigned int tick) {
 				}
 			}
 			animationTick = 0;
-			activeTexture = textureFrames[textureFrameIndex];
+			setTexture(textureFrames[textureFrameIndex]);
 		}
 	}
 	effectTick++;
@@ -50,21 +48,19 @@ void Sprite::update(unsigned int tick) {
 	}
 }
 
-void Sprite::render(SDL_Rect& worldCoordinates, SDL_Renderer* renderer) const {
+void Sprite::render(SDL_Rect& worldCoordinates, SpriteBatch& batch) const {
 	if (activeTexture) {
-		//Setting the sprite alpha value to the texture
-		SDL_SetTextureAlphaMod(activeTexture, alpha);
-
-		//Rendering the active texture, optionally rotating or flipping it according to the sprite settings
-		SDL_Rect scaled = scaleRectangle(&worldCoordinates, scaleX, scaleY, scalingOrigin);
-		SDL_RenderCopyEx(renderer, activeTexture, &textureCoordinates, &scaled, rotationAngle, rotationOrigin, renderFlip);
+		//Rendering the active texture region with the sprite colour and alpha, optionally rotating or flipping it according to the sprite settings
+		const SDL_Rect scaled = scaleRectangle(&worldCoordinates, scaleX, scaleY, scalingOrigin);
+		const SDL_Color color{ colorMod.r, colorMod.g, colorMod.b, static_cast<Uint8>(alpha) };
+		batch.draw(activeTexture, textureCoordinates, scaled, color, rotationAngle, rotationOrigin, renderFlip);
 	}
 }
 
-void Sprite::setTexture(SDL_Texture * texture) {
-	activeTexture = texture;
-	textureCoordinates = Utils::createSDLRect(0, 0, 0, 0);
-	SDL_QueryTexture(texture, NULL, NULL, &textureCoordinates.w, &textureCoordinates.h);
+void Sprite::setTexture(const TextureRegion& texture) {
+	activeTexture = texture.texture;
+	textureCoordinates = texture.rect;
+	colorMod = texture.colorMod;
 }
 
 void Sprite::setRotationOrigin(SDL_Point point) {
@@ -107,7 +103,7 @@ void Sprite::setAnimationSpeed(int ticksPerFrame) {
 	animationTicksPerFrame = ticksPerFrame;
 }
 
-void Sprite::addAnimationFrame(SDL_Texture * frame) {
+void Sprite::addAnimationFrame(const TextureRegion& frame) {
 	textureFrames.push_back(frame);
 }
 
@@ -2,6 +2,9 @@
 
 #include <SDL_render.h>
 
+#include "TextureAtlas.h"
+#include "SpriteBatch.h"
+
 #include <vector>
 
 /*!
@@ -34,15 +37,18 @@ private:
 	int textureFrameIndex = 0;
 	int effectTick = 0;
 	
-	/*! Set of textures used for animation */
-	std::vector<SDL_Texture*> textureFrames{};
+	/*! Set of texture regions used for animation */
+	std::vector<TextureRegion> textureFrames{};
 
 	/*! Rectangle specifying the texture region in texture space */
 	SDL_Rect textureCoordinates;
 
-	/*! The texture used when rendering this entity */
+	/*! The texture used when rendering this entity, usually a texture atlas page */
 	SDL_Texture* activeTexture;
 
+	/*! Colour modulation of the active texture region, applied on every draw as the texture is shared. */
+	SDL_Color colorMod;
+
 	SDL_Point* rotationOrigin = nullptr;
 	double rotationAngle = 0;
 
@@ -77,7 +83,7 @@ private:
 	/*! Current active effect */
 	SpriteEffect activeEffect = NONE;
 public:
-	Sprite(SDL_Texture* texture);
+	Sprite(const TextureRegion& texture);
 
 	/*!
 	 * Handling animation, switching to the next frame or reseting to the first one if necessary
@@ -87,14 +93,14 @@ public:
 	/*!
 	 * Renders the sprite using its current parameters.
 	 * \param worldCoordinates Target world coordinates where the sprite texture should be rendered at.
-	 * \param renderer The SDL renderer used for rendering.
+	 * \param batch The sprite batch the sprite quad is added to.
 	 */
-	void render(SDL_Rect& worldCoordinates, SDL_Renderer* renderer) const;
+	void render(SDL_Rect& worldCoordinates, SpriteBatch& batch) const;
 
 	/*!
-	 * Sets the sprite activeTexture, recalculating texture coordinates.
+	 * Sets the sprite activeTexture, texture coordinates and colour modulation to a texture region.
 	 */
-	void setTexture(SDL_Texture* texture);
+	void setTexture(const TextureRegion& texture);
 	void setRotationOrigin(SDL_Point point);
 	
 	/*!
@@ -136,7 +142,7 @@ public:
 	 * Adds an animation frame to the sprite. The animation frames should be added
 	 * in the order in which they are to be displayed.
 	 */
-	void addAnimationFrame(SDL_Texture* frame);
+	void addAnimationFrame(const TextureRegion& frame);
 	void clearAnimationFrames();
 
 	/*!
@@ -0,0 +1,79 @@
+#include "SpriteBatch.h"
+
+#include <cmath>
+#include <utility>
+
+SpriteBatch::SpriteBatch(SDL_Renderer* renderer) : renderer(renderer) {
+
+}
+
+void SpriteBatch::draw(SDL_Texture* texture, const SDL_Rect& source, const SDL_Rect& destination, SDL_Color color,
+	double angle, const SDL_Point* center, SDL_RendererFlip flip) {
+	if (!texture) {
+		return;
+	}
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+	if (texture != this->texture) {
+		flush();
+		this->texture = texture;
+		SDL_QueryTexture(texture, NULL, NULL, &textureWidth, &textureHeight);
+	}
+
+	//Texture coordinates of the corners, flipping swaps the opposite edges
+	float left = static_cast<float>(source.x) / textureWidth;
+	float right = static_cast<float>(source.x + source.w) / textureWidth;
+	float top = static_cast<float>(source.y) / textureHeight;
+	float bottom = static_cast<float>(source.y + source.h) / textureHeight;
+	if (flip & SDL_FLIP_HORIZONTAL) std::swap(left, right);
+	if (flip & SDL_FLIP_VERTICAL) std::swap(top, bottom);
+
+	//Corners relative to the rotation center, rotated clockwise in screen space
+	const float centerX = destination.x + (center ? center->x : destination.w / 2.0f);
+	const float centerY = destination.y + (center ? center->y : destination.h / 2.0f);
+	const float cornersX[4] = { destination.x - centerX, destination.x + destination.w - centerX, destination.x + destination.w - centerX, destination.x - centerX };
+	const float cornersY[4] = { destination.y - centerY, destination.y - centerY, destination.y + destination.h - centerY, destination.y + destination.h - centerY };
+	const float u[4] = { left, right, right, left };
+	const float v[4] = { top, top, bottom, bottom };
+	const float radians = static_cast<float>(angle * M_PI / 180.0);
+	const float cosine = angle != 0 ? std::cos(radians) : 1.0f;
+	const float sine = angle != 0 ? std::sin(radians) : 0.0f;
+
+	const int firstVertex = static_cast<int>(vertices.size());
+	for (int i = 0; i < 4; i++) {
+		SDL_Vertex vertex;
+		vertex.position.x = centerX + cornersX[i] * cosine - cornersY[i] * sine;
+		vertex.position.y = centerY + cornersX[i] * sine + cornersY[i] * cosine;
+		vertex.color = color;
+		vertex.tex_coord.x = u[i];
+		vertex.tex_coord.y = v[i];
+		vertices.push_back(vertex);
+	}
+	const int quadIndices[6] = { 0, 1, 2, 0, 2, 3 };
+	for (const int index : quadIndices) {
+		indices.push_back(firstVertex + index);
+	}
+#else
+	SDL_SetTextureColorMod(texture, color.r, color.g, color.b);
+	SDL_SetTextureAlphaMod(texture, color.a);
+	SDL_RenderCopyEx(renderer, texture, &source, &destination, angle, center, flip);
+#endif
+}
+
+void SpriteBatch::flush() {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+	if (!vertices.empty()) {
+		//The modulation is stored in the vertex colours, the texture itself must not modulate them again
+		SDL_SetTextureColorMod(texture, 255, 255, 255);
+		SDL_SetTextureAlphaMod(texture, 255);
+		SDL_RenderGeometry(renderer, texture, vertices.data(), static_cast<int>(vertices.size()), indices.data(), static_cast<int>(indices.size()));
+		vertices.clear();
+		indices.clear();
+	}
+	texture = nullptr;
+#endif
+}
+
+SDL_Renderer* SpriteBatch::getRenderer() const {
+	return renderer;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "SDL.h"
+
+#include <vector>
+
+/*!
+ * Collects textured quads and submits consecutive quads with the same texture in a single SDL_RenderGeometry call.
+ *
+ * Quads are drawn in the order they were added, so the batch is flushed whenever the texture changes.
+ * As all sprite textures are packed into a texture atlas, the number of draw calls of a frame
+ * does not grow with the number of rendered entities.
+ * The batch must be flushed before anything else is drawn with the renderer or the render target is changed.
+ * Without SDL_RenderGeometry (SDL older than 2.0.18) every quad is drawn immediately with SDL_RenderCopyEx.
+ */
+class SpriteBatch {
+private:
+	SDL_Renderer* renderer;
+
+	/*! Texture of the queued quads. */
+	SDL_Texture* texture = nullptr;
+	int textureWidth = 0;
+	int textureHeight = 0;
+
+	std::vector<SDL_Vertex> vertices;
+	std::vector<int> indices;
+public:
+	SpriteBatch(SDL_Renderer* renderer);
+
+	/*!
+	 * Adds a textured quad to the batch.
+	 *
+	 * \param texture The texture, quads with a nullptr texture are ignored.
+	 * \param source The texture region in texture space.
+	 * \param destination The target rectangle.
+	 * \param color Colour and alpha modulation of the quad.
+	 * \param angle Rotation angle in degrees, rotating clockwise.
+	 * \param center Rotation center relative to the destination rectangle, a nullptr rotates around the rectangle center.
+	 * \param flip Flipping of the texture region.
+	 */
+	void draw(SDL_Texture* texture, const SDL_Rect& source, const SDL_Rect& destination, SDL_Color color,
+		double angle = 0, const SDL_Point* center = nullptr, SDL_RendererFlip flip = SDL_FLIP_NONE);
+
+	/*!
+	 * Submits all queued quads to the renderer.
+	 */
+	void flush();
+
+	SDL_Renderer* getRenderer() const;
+};
@@ -0,0 +1,46 @@
+#include "TextCache.h"
+
+TextCache::TextCache(SDL_Renderer* renderer) : renderer(renderer) {
+
+}
+
+TextCache::~TextCache() {
+	clear();
+}
+
+void TextCache::renderText(const std::string& key, const std::string& text, const SDL_Rect& targetRect, Renderer::TextAlign textAlign, TTF_Font* font, SDL_Color color) {
+	if (text.empty()) {
+		return;
+	}
+
+	Entry& entry = entries[key];
+	if (!entry.texture || entry.text != text || entry.font != font
+		|| entry.color.r != color.r || entry.color.g != color.g || entry.color.b != color.b || entry.color.a != color.a) {
+		SDL_DestroyTexture(entry.texture);
+		entry.texture = nullptr;
+		entry.text = text;
+		entry.font = font;
+		entry.color = color;
+
+		SDL_Surface* textSurface = TTF_RenderText_Solid(font, text.c_str(), color);
+		if (textSurface) {
+			entry.texture = SDL_CreateTextureFromSurface(renderer, textSurface);
+			entry.width = textSurface->w;
+			entry.height = textSurface->h;
+			SDL_FreeSurface(textSurface);
+		}
+		if (!entry.texture) {
+			return;
+		}
+	}
+
+	const SDL_Rect textRect = Renderer::alignText(targetRect, entry.width, entry.height, textAlign);
+	SDL_RenderCopy(renderer, entry.texture, NULL, &textRect);
+}
+
+void TextCache::clear() {
+	for (auto& entry : entries) {
+		SDL_DestroyTexture(entry.second.texture);
+	}
+	entries.clear();
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "SDL.h"
+#include <SDL_ttf.h>
+
+#include "Renderer.h"
+
+#include <string>
+#include <unordered_map>
+
+/*!
+ * Keeps rendered text textures between frames.
+ *
+ * Every text drawn through the cache has a key identifying its place on the screen.
+ * The texture of a key is only rendered again when the text, font or colour of the key changes,
+ * so texts that rarely change cost a single texture copy per frame.
+ */
+class TextCache {
+private:
+	struct Entry {
+		std::string text;
+		TTF_Font* font = nullptr;
+		SDL_Color color{ 0, 0, 0, 0 };
+		SDL_Texture* texture = nullptr;
+		int width = 0;
+		int height = 0;
+	};
+
+	SDL_Renderer* renderer;
+	std::unordered_map<std::string, Entry> entries;
+public:
+	TextCache(SDL_Renderer* renderer);
+	~TextCache();
+
+	TextCache(const TextCache&) = delete;
+	TextCache& operator= (const TextCache&) = delete;
+
+	/*!
+	 * Renders aligned text, rendering its texture first if the text of the key changed.
+	 *
+	 * \param key Key identifying the text.
+	 * \param text The text content.
+	 * \param targetRect Destination rectangle, width and height may be optional based on alignment.
+	 * \param textAlign Text alignment.
+	 * \param font The font of the text.
+	 * \param color Color of the text.
+	 * \see Renderer::TextAlign
+	 */
+	void renderText(const std::string& key, const std::string& text, const SDL_Rect& targetRect, Renderer::TextAlign textAlign, TTF_Font* font, SDL_Color color);
+
+	/*!
+	 * Frees all cached textures.
+	 */
+	void clear();
+};
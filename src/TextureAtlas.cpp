@@ -0,0 +1,154 @@
+#include "TextureAtlas.h"
+
+#include "SDL_image.h"
+
+#include <algorithm>
+#include <iostream>
+
+const int TextureAtlas::PAGE_SIZE;
+const int TextureAtlas::PADDING;
+
+TextureRegion TextureRegion::tinted(Uint8 r, Uint8 g, Uint8 b) const {
+	TextureRegion region = *this;
+	region.colorMod = SDL_Color{ r, g, b, 255 };
+	return region;
+}
+
+TextureAtlas::~TextureAtlas() {
+	dispose();
+}
+
+int TextureAtlas::addImage(const std::string& path) {
+	std::cout << "Loading texture: " << path << std::endl;
+	SDL_Surface* surface = IMG_Load(path.c_str());
+	if (!surface) {
+		std::cerr << "Failed to load image " << path << "! " << IMG_GetError() << std::endl;
+		return -1;
+	}
+	return addSurface(path, surface);
+}
+
+int TextureAtlas::addSurface(const std::string& name, SDL_Surface* surface) {
+	if (!surface) {
+		std::cerr << "Failed to add image " << name << " to the texture atlas!" << std::endl;
+		return -1;
+	}
+	images.push_back(Image{ name, surface, -1, SDL_Rect{ 0, 0, surface->w, surface->h } });
+	return static_cast<int>(images.size()) - 1;
+}
+
+bool TextureAtlas::build(SDL_Renderer* renderer) {
+	int pageSize = PAGE_SIZE;
+	SDL_RendererInfo rendererInfo;
+	if (SDL_GetRendererInfo(renderer, &rendererInfo) == 0 && rendererInfo.max_texture_width > 0 && rendererInfo.max_texture_height > 0) {
+		pageSize = std::min(pageSize, std::min(rendererInfo.max_texture_width, rendererInfo.max_texture_height));
+	}
+
+	//Images are packed from the tallest to the shortest, so the shelves waste little space
+	std::vector<size_t> order;
+	for (size_t i = 0; i < images.size(); i++) {
+		if (images[i].surface) {
+			order.push_back(i);
+		}
+	}
+	std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+		return images[a].rect.h > images[b].rect.h;
+	});
+
+	//Shelf packing, every page is filled row by row, the height of a row is the height of its first image
+	std::vector<SDL_Point> pageSizes;
+	int shelfX = 0;
+	int shelfY = 0;
+	int shelfHeight = 0;
+	int sharedPage = -1;
+	for (const size_t i : order) {
+		Image& image = images[i];
+		const int width = image.rect.w + PADDING;
+		const int height = image.rect.h + PADDING;
+		if (width > pageSize || height > pageSize) {
+			image.page = static_cast<int>(pageSizes.size());
+			image.rect.x = 0;
+			image.rect.y = 0;
+			pageSizes.push_back(SDL_Point{ image.rect.w, image.rect.h });
+			continue;
+		}
+		if (sharedPage >= 0 && shelfX + width > pageSize) {
+			shelfX = 0;
+			shelfY += shelfHeight;
+			shelfHeight = 0;
+		}
+		if (sharedPage < 0 || shelfY + height > pageSize) {
+			sharedPage = static_cast<int>(pageSizes.size());
+			pageSizes.push_back(SDL_Point{ 0, 0 });
+			shelfX = 0;
+			shelfY = 0;
+			shelfHeight = 0;
+		}
+		image.page = sharedPage;
+		image.rect.x = shelfX;
+		image.rect.y = shelfY;
+		shelfX += width;
+		shelfHeight = std::max(shelfHeight, height);
+		pageSizes[sharedPage].x = std::max(pageSizes[sharedPage].x, shelfX);
+		pageSizes[sharedPage].y = std::max(pageSizes[sharedPage].y, shelfY + shelfHeight);
+	}
+
+	//Copying the images to page surfaces and uploading them as textures
+	bool success = true;
+	for (size_t page = 0; page < pageSizes.size(); page++) {
+		SDL_Surface* pageSurface = SDL_CreateRGBSurfaceWithFormat(0, pageSizes[page].x, pageSizes[page].y, 32, SDL_PIXELFORMAT_RGBA32);
+		if (!pageSurface) {
+			std::cerr << "Failed to create a texture atlas page! " << SDL_GetError() << std::endl;
+			pages.push_back(nullptr);
+			success = false;
+			continue;
+		}
+		for (Image& image : images) {
+			if (image.surface && image.page == static_cast<int>(page)) {
+				//Copying the pixels including their alpha instead of blending them over the empty page
+				SDL_SetSurfaceBlendMode(image.surface, SDL_BLENDMODE_NONE);
+				SDL_Rect target = image.rect;
+				SDL_BlitSurface(image.surface, NULL, pageSurface, &target);
+			}
+		}
+		SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, pageSurface);
+		SDL_FreeSurface(pageSurface);
+		if (!texture) {
+			std::cerr << "Failed to create a texture atlas page texture! " << SDL_GetError() << std::endl;
+			success = false;
+		}
+		pages.push_back(texture);
+	}
+
+	for (Image& image : images) {
+		SDL_FreeSurface(image.surface);
+		image.surface = nullptr;
+	}
+	std::cout << "Packed " << order.size() << " images into " << pages.size() << " texture atlas pages" << std::endl;
+	return success;
+}
+
+TextureRegion TextureAtlas::getRegion(int image) const {
+	TextureRegion region;
+	if (image >= 0 && image < static_cast<int>(images.size()) && images[image].page >= 0
+		&& images[image].page < static_cast<int>(pages.size())) {
+		region.texture = pages[images[image].page];
+		region.rect = images[image].rect;
+	}
+	return region;
+}
+
+int TextureAtlas::getPageCount() const {
+	return static_cast<int>(pages.size());
+}
+
+void TextureAtlas::dispose() {
+	for (Image& image : images) {
+		SDL_FreeSurface(image.surface);
+	}
+	images.clear();
+	for (SDL_Texture* page : pages) {
+		SDL_DestroyTexture(page);
+	}
+	pages.clear();
+}
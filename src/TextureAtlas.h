@@ -0,0 +1,95 @@
+#pragma once
+
+#include "SDL.h"
+
+#include <string>
+#include <vector>
+
+/*!
+ * A rectangular region of a texture that sprites are rendered from, usually an image packed into a TextureAtlas.
+ * The colour modulation is applied on every draw, tinted variants of an image share the pixels of the image.
+ */
+struct TextureRegion {
+	/*! The texture containing the region, a nullptr for an empty region that is not rendered. */
+	SDL_Texture* texture = nullptr;
+	/*! The region in texture space. */
+	SDL_Rect rect{ 0, 0, 0, 0 };
+	/*! Colour modulation of the region, white renders the original colours. */
+	SDL_Color colorMod{ 255, 255, 255, 255 };
+
+	/*!
+	 * Returns a copy of the region with a colour modulation.
+	 */
+	TextureRegion tinted(Uint8 r, Uint8 g, Uint8 b) const;
+};
+
+/*!
+ * Packs many small images into a few large page textures, so consecutive draws of different sprites
+ * use the same texture and the renderer can batch them.
+ *
+ * Images are added with addImage() and packed with build(). The images are placed on shelves
+ * of pages of PAGE_SIZE pixels, images larger than a page get a page of their own.
+ * The regions of the images can be queried once the atlas was built.
+ */
+class TextureAtlas {
+public:
+	/*! Preferred width and height of a page, smaller if the renderer does not support textures this large. */
+	static const int PAGE_SIZE = 512;
+
+	/*! Transparent pixels kept between the images so that filtering does not bleed neighbouring images into each other. */
+	static const int PADDING = 1;
+private:
+	struct Image {
+		std::string path;
+		/*! The loaded image, freed once it was copied to its page. */
+		SDL_Surface* surface;
+		int page;
+		SDL_Rect rect;
+	};
+
+	std::vector<Image> images;
+	std::vector<SDL_Texture*> pages;
+public:
+	TextureAtlas() = default;
+	~TextureAtlas();
+
+	TextureAtlas(const TextureAtlas&) = delete;
+	TextureAtlas& operator= (const TextureAtlas&) = delete;
+
+	/*!
+	 * Loads an image that will be packed into the atlas.
+	 *
+	 * \param path Path to the image file.
+	 * \return Id of the image used to get its region, -1 if the image could not be loaded.
+	 */
+	int addImage(const std::string& path);
+
+	/*!
+	 * Adds an image surface that will be packed into the atlas, the atlas takes the ownership of the surface.
+	 *
+	 * \param name Name of the image used in messages.
+	 * \param surface The image, can be a nullptr.
+	 * \return Id of the image used to get its region, -1 if the surface is a nullptr.
+	 */
+	int addSurface(const std::string& name, SDL_Surface* surface);
+
+	/*!
+	 * Packs all added images into page textures.
+	 *
+	 * \param renderer The renderer the page textures are created with.
+	 * \return true on success, false if a page texture could not be created.
+	 */
+	bool build(SDL_Renderer* renderer);
+
+	/*!
+	 * Returns the region of an added image, an empty region for an invalid id or before the atlas is built.
+	 */
+	TextureRegion getRegion(int image) const;
+
+	int getPageCount() const;
+
+	/*!
+	 * Frees all images and page textures.
+	 */
+	void dispose();
+};
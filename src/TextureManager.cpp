@@ -1,103 +1,103 @@
 #include "TextureManager.h"
 
-#include "SDL_image.h"
-
 #include <iostream>
+#include <utility>
 
-SDL_Texture* TextureManager::bombermanTexture;
-SDL_Texture* TextureManager::bombermanTextureTinted;
+TextureRegion TextureManager::bombermanTexture;
+TextureRegion TextureManager::bombermanTextureTinted;
 
-SDL_Texture* TextureManager::bombNoFireTexture;
-SDL_Texture* TextureManager::bombFrame1;
-SDL_Texture* TextureManager::bombFrame2;
-SDL_Texture* TextureManager::bombFrame3;
+TextureRegion TextureManager::bombNoFireTexture;
+TextureRegion TextureManager::bombFrame1;
+TextureRegion TextureManager::bombFrame2;
+TextureRegion TextureManager::bombFrame3;
 
-SDL_Texture* TextureManager::wallTexture;
-SDL_Texture* TextureManager::indestructibleEdgeWallTexture;
-SDL_Texture* TextureManager::indestructibleWallTexture;
+TextureRegion TextureManager::wallTexture;
+TextureRegion TextureManager::indestructibleEdgeWallTexture;
+TextureRegion TextureManager::indestructibleWallTexture;
 
-std::vector<SDL_Texture*> TextureManager::wallExplosionAnimation;
+std::vector<TextureRegion> TextureManager::wallExplosionAnimation;
 
-SDL_Texture* TextureManager::tileTexture;
-SDL_Texture* TextureManager::tileTextureDark;
+TextureRegion TextureManager::tileTexture;
+TextureRegion TextureManager::tileTextureDark;
 
-SDL_Texture* TextureManager::defaultTexture;
+TextureRegion TextureManager::defaultTexture;
 
-SDL_Texture* TextureManager::bombCountDownTexture;
-SDL_Texture* TextureManager::bombCountUpTexture;
+TextureRegion TextureManager::bombCountDownTexture;
+TextureRegion TextureManager::bombCountUpTexture;
 
-SDL_Texture* TextureManager::bombCountIcon;
-SDL_Texture* TextureManager::bombPowerIcon;
+TextureRegion TextureManager::bombCountIcon;
+TextureRegion TextureManager::bombPowerIcon;
 
-SDL_Texture* TextureManager::bombPowerDownTexture;
-SDL_Texture* TextureManager::bombPowerUpTexture;
+TextureRegion TextureManager::bombPowerDownTexture;
+TextureRegion TextureManager::bombPowerUpTexture;
 
-SDL_Texture* TextureManager::speedPowerUp;
-SDL_Texture* TextureManager::speedPowerUpIcon;
+TextureRegion TextureManager::speedPowerUp;
+TextureRegion TextureManager::speedPowerUpIcon;
 
-SDL_Texture* TextureManager::explosionCenter;
-SDL_Texture* TextureManager::explosionEnd;
-SDL_Texture* TextureManager::explosionSide;
+TextureRegion TextureManager::explosionCenter;
+TextureRegion TextureManager::explosionEnd;
+TextureRegion TextureManager::explosionSide;
 
-SDL_Texture* TextureManager::health;
+TextureRegion TextureManager::health;
 
-SDL_Texture* TextureManager::playerIcon;
-SDL_Texture* TextureManager::computerIcon;
+TextureRegion TextureManager::playerIcon;
+TextureRegion TextureManager::computerIcon;
 
-SDL_Texture* TextureManager::cross;
+TextureRegion TextureManager::cross;
 
 bool TextureManager::texturesLoaded = false;
 
+TextureAtlas TextureManager::atlas;
+
 void TextureManager::loadAllTextures(SDL_Renderer* renderer) {
 	if (!texturesLoaded) {
 		std::cout << "Loading textures" << std::endl;
 
-		bombermanTexture = loadTexture("res/player16.png", renderer);
-		bombermanTextureTinted = loadTexture("res/player16.png", renderer);
-		SDL_SetTextureColorMod(bombermanTextureTinted, 255, 128, 128);
-
-		bombNoFireTexture = loadTexture("res/bomb16_0.png", renderer);
-		bombFrame1 = loadTexture("res/bomb16_1.png", renderer);
-		bombFrame2 = loadTexture("res/bomb16_2.png", renderer);
-		bombFrame3 = loadTexture("res/bomb16_3.png", renderer);
-
-		wallTexture = loadTexture("res/wall16.png", renderer);
-		indestructibleWallTexture = loadTexture("res/inwall16_dark.png", renderer);
-		indestructibleEdgeWallTexture = loadTexture("res/inwall16_edge2.png", renderer);
-		
-		wallExplosionAnimation.push_back(loadTexture("res/wall2.png", renderer));
-		wallExplosionAnimation.push_back(loadTexture("res/wall3.png", renderer));
-		wallExplosionAnimation.push_back(loadTexture("res/wall4.png", renderer));
-		wallExplosionAnimation.push_back(loadTexture("res/wall5.png", renderer));
-		
-		tileTexture = loadTexture("res/tile16.png", renderer);
-		tileTextureDark = loadTexture("res/tile16.png", renderer);
-		SDL_SetTextureColorMod(tileTextureDark, 128, 128, 128);
-
-		defaultTexture = loadTexture("res/default16.png", renderer);
-
-		bombCountDownTexture = loadTexture("res/bombCountDown16.png", renderer);
-		bombCountUpTexture = loadTexture("res/bombCountUp16.png", renderer);
-
-		bombCountIcon = loadTexture("res/bombCountIcon.png", renderer);
-		bombPowerIcon = loadTexture("res/bombPowerIcon.png", renderer);
-		
-		bombPowerDownTexture = loadTexture("res/bombPowerDown16.png", renderer);
-		bombPowerUpTexture = loadTexture("res/bombPowerUp16.png", renderer);
-
-		speedPowerUp = loadTexture("res/speed16.png", renderer);
-		speedPowerUpIcon = loadTexture("res/speedPowerUpIcon.png", renderer);
-
-		explosionCenter = loadTexture("res/explosionCenter.png", renderer);
-		explosionEnd = loadTexture("res/explosionEnd.png", renderer);
-		explosionSide = loadTexture("res/explosionSide.png", renderer);
-
-		health = loadTexture("res/health.png", renderer);
-
-		playerIcon = loadTexture("res/player22.png", renderer);
-		computerIcon = loadTexture("res/computer22.png", renderer);
+		wallExplosionAnimation.resize(4);
+		const std::pair<const char*, TextureRegion*> images[] = {
+			{ "res/player16.png", &bombermanTexture },
+			{ "res/bomb16_0.png", &bombNoFireTexture },
+			{ "res/bomb16_1.png", &bombFrame1 },
+			{ "res/bomb16_2.png", &bombFrame2 },
+			{ "res/bomb16_3.png", &bombFrame3 },
+			{ "res/wall16.png", &wallTexture },
+			{ "res/inwall16_dark.png", &indestructibleWallTexture },
+			{ "res/inwall16_edge2.png", &indestructibleEdgeWallTexture },
+			{ "res/wall2.png", &wallExplosionAnimation[0] },
+			{ "res/wall3.png", &wallExplosionAnimation[1] },
+			{ "res/wall4.png", &wallExplosionAnimation[2] },
+			{ "res/wall5.png", &wallExplosionAnimation[3] },
+			{ "res/tile16.png", &tileTexture },
+			{ "res/default16.png", &defaultTexture },
+			{ "res/bombCountDown16.png", &bombCountDownTexture },
+			{ "res/bombCountUp16.png", &bombCountUpTexture },
+			{ "res/bombCountIcon.png", &bombCountIcon },
+			{ "res/bombPowerIcon.png", &bombPowerIcon },
+			{ "res/bombPowerDown16.png", &bombPowerDownTexture },
+			{ "res/bombPowerUp16.png", &bombPowerUpTexture },
+			{ "res/speed16.png", &speedPowerUp },
+			{ "res/speedPowerUpIcon.png", &speedPowerUpIcon },
+			{ "res/explosionCenter.png", &explosionCenter },
+			{ "res/explosionEnd.png", &explosionEnd },
+			{ "res/explosionSide.png", &explosionSide },
+			{ "res/health.png", &health },
+			{ "res/player22.png", &playerIcon },
+			{ "res/computer22.png", &computerIcon },
+			{ "res/cross64.png", &cross }
+		};
+
+		std::vector<int> imageIds;
+		for (auto& image : images) {
+			imageIds.push_back(atlas.addImage(image.first));
+		}
+		atlas.build(renderer);
+		for (size_t i = 0; i < imageIds.size(); i++) {
+			*images[i].second = atlas.getRegion(imageIds[i]);
+		}
 
-		cross = loadTexture("res/cross64.png", renderer);
+		//Tinted textures share the pixels of the original image
+		bombermanTextureTinted = bombermanTexture.tinted(255, 128, 128);
+		tileTextureDark = tileTexture.tinted(128, 128, 128);
 		
 		texturesLoaded = true;
 	} else {
@@ -108,51 +108,8 @@ void TextureManager::loadAllTextures(SDL_Renderer* renderer) {
 void TextureManager::dispose() {
 	if (texturesLoaded) {
 		std::cout << "Disposing textures" << std::endl;
-
-		SDL_DestroyTexture(bombermanTexture);
-		SDL_DestroyTexture(bombermanTextureTinted);
-		SDL_DestroyTexture(bombNoFireTexture);
-		SDL_DestroyTexture(bombFrame1);
-		SDL_DestroyTexture(bombFrame2);
-		SDL_DestroyTexture(bombFrame3);
-		SDL_DestroyTexture(wallTexture);
-		SDL_DestroyTexture(indestructibleWallTexture);
-		SDL_DestroyTexture(indestructibleEdgeWallTexture);
-		for (auto& texture : wallExplosionAnimation) {
-			SDL_DestroyTexture(texture);
-		}
-		SDL_DestroyTexture(tileTexture);
-		SDL_DestroyTexture(tileTextureDark);
-		SDL_DestroyTexture(defaultTexture);
-		SDL_DestroyTexture(bombCountDownTexture);
-		SDL_DestroyTexture(bombCountUpTexture);
-		SDL_DestroyTexture(bombCountIcon);
-		SDL_DestroyTexture(bombPowerIcon);
-		SDL_DestroyTexture(bombPowerDownTexture);
-		SDL_DestroyTexture(bombPowerUpTexture);
-		SDL_DestroyTexture(speedPowerUp);
-		SDL_DestroyTexture(speedPowerUpIcon);
-		SDL_DestroyTexture(explosionCenter);
-		SDL_DestroyTexture(explosionEnd);
-		SDL_DestroyTexture(explosionSide);
-		SDL_DestroyTexture(health);
-		SDL_DestroyTexture(playerIcon);
-		SDL_DestroyTexture(computerIcon);
-		SDL_DestroyTexture(cross);
+		atlas.dispose();
 	} else {
 		std::cout << "TextureManager dispose was called but textures haven't been loaded yet!" << std::endl;
 	}
 }
-
-Particle * TextureManager::createWallDestructionEffect() {
-	return new Particle(wallExplosionAnimation, 6, false, 0, 32, 32, 64, 64);
-}
-
-SDL_Texture * TextureManager::loadTexture(const char * path, SDL_Renderer* renderer) {
-	std::cout << "Loading texture: " << path << std::endl;
-	SDL_Surface* newSurface = IMG_Load(path);
-	SDL_Texture* newTexture = SDL_CreateTextureFromSurface(renderer, newSurface);
-	SDL_FreeSurface(newSurface);
-
-	return newTexture;
-}
\ No newline at end of file
@@ -4,54 +4,57 @@
 
 #include <vector>
 
-#include "Particle.h"
+#include "TextureAtlas.h"
 
 /*!
  * Class responsible for loading textures and provides static access to them. 
+ * All images are packed into a shared texture atlas, the textures are regions of the atlas pages.
+ * The textures are only loaded and freed by a windowed game, headless games never modify them,
+ * so any number of headless games can run in parallel next to each other.
  */
 class TextureManager {
 public:
-	static SDL_Texture* bombermanTexture;
-	static SDL_Texture* bombermanTextureTinted;
+	static TextureRegion bombermanTexture;
+	static TextureRegion bombermanTextureTinted;
 	
-	static SDL_Texture* bombNoFireTexture;
-	static SDL_Texture* bombFrame1;
-	static SDL_Texture* bombFrame2;
-	static SDL_Texture* bombFrame3;
+	static TextureRegion bombNoFireTexture;
+	static TextureRegion bombFrame1;
+	static TextureRegion bombFrame2;
+	static TextureRegion bombFrame3;
 
-	static SDL_Texture* wallTexture;
-	static SDL_Texture* indestructibleEdgeWallTexture;
-	static SDL_Texture* indestructibleWallTexture;
+	static TextureRegion wallTexture;
+	static TextureRegion indestructibleEdgeWallTexture;
+	static TextureRegion indestructibleWallTexture;
 
-	static std::vector<SDL_Texture*> wallExplosionAnimation;
+	static std::vector<TextureRegion> wallExplosionAnimation;
 
-	static SDL_Texture* tileTexture;
-	static SDL_Texture* tileTextureDark;
+	static TextureRegion tileTexture;
+	static TextureRegion tileTextureDark;
 
-	static SDL_Texture* defaultTexture;
+	static TextureRegion defaultTexture;
 
-	static SDL_Texture* bombCountDownTexture;
-	static SDL_Texture* bombCountUpTexture;
+	static TextureRegion bombCountDownTexture;
+	static TextureRegion bombCountUpTexture;
 
-	static SDL_Texture* bombCountIcon;
-	static SDL_Texture* bombPowerIcon;
+	static TextureRegion bombCountIcon;
+	static TextureRegion bombPowerIcon;
 	
-	static SDL_Texture* bombPowerDownTexture;
-	static SDL_Texture* bombPowerUpTexture;
+	static TextureRegion bombPowerDownTexture;
+	static TextureRegion bombPowerUpTexture;
 
-	static SDL_Texture* speedPowerUp;
-	static SDL_Texture* speedPowerUpIcon;
+	static TextureRegion speedPowerUp;
+	static TextureRegion speedPowerUpIcon;
 
-	static SDL_Texture* explosionCenter;
-	static SDL_Texture* explosionEnd;
-	static SDL_Texture* explosionSide;
+	static TextureRegion explosionCenter;
+	static TextureRegion explosionEnd;
+	static TextureRegion explosionSide;
 
-	static SDL_Texture* health;
+	static TextureRegion health;
 
-	static SDL_Texture* playerIcon;
-	static SDL_Texture* computerIcon;
+	static TextureRegion playerIcon;
+	static TextureRegion computerIcon;
 
-	static SDL_Texture* cross;
+	static TextureRegion cross;
 
 	/*!
 	 * Loads all textures if they aren't loaded already.
@@ -62,16 +65,8 @@ public:
 	 * Frees texture resources.
 	 */
 	static void dispose();
-
-	static Particle* createWallDestructionEffect();
 private:
 	static bool texturesLoaded;
 
-	/*!
-	 * Loads a texture from an image file.
-	 * 
-	 * \param path Path to the image file.
-	 * \param renderer The renderer.
-	 */
-	static SDL_Texture* loadTexture(const char* path, SDL_Renderer* renderer);
+	static TextureAtlas atlas;
 };
\ No newline at end of file
@@ -1,33 +1,26 @@
 #include "Tile.h"
 
 #include "TextureManager.h"
-#include "Utils.h"
 #include "BombCountModifier.h"
 #include "BombPowerModifier.h"
 #include "Constants.h"
 #include "EntityManager.h"
 #include "Game.h"
+#include "Map.h"
 #include "HealthPickup.h"
 #include "SpeedPowerUp.h"
-#include "Particle.h"
+#include "ParticleSystem.h"
 
-Tile::Tile(int initialX, int initialY)
-: Entity(TextureManager::tileTexture, initialX, initialY, Constants::TILE_SIZE, Constants::TILE_SIZE) {
+Tile::Tile(Map* map, int column, int row, int tileSize)
+: Entity(TextureManager::tileTexture, column * tileSize, row * tileSize, Constants::TILE_SIZE, Constants::TILE_SIZE),
+map(map), index(row * map->mapTileWidth + column), column(column), row(row) {
 	this->setCollidable(false);
 	this->setRenderingExternal(true);
 }
 
-void Tile::update(Game* game) {
-	if (ticksToExplosion > 0) {
-		ticksToExplosion--;
-	} else {
-		bombPlaced = false;
-	}
-}
-
-void Tile::render(SDL_Renderer* renderer) {
-	if (wall) {
-		if (indestructible) {
+void Tile::render(SpriteBatch& batch) {
+	if (isWall()) {
+		if (isIndestructible()) {
 			if (edgeWall) {
 				this->sprite.setTexture(TextureManager::indestructibleEdgeWallTexture);
 			} else {
@@ -39,23 +32,18 @@ void Tile::render(SDL_Renderer* renderer) {
 	} else {
 		this->sprite.setTexture(TextureManager::tileTexture);
 	}
-	Entity::render(renderer);
-
-	if (Game::showAI) {
-		if (this->isDangerous() || this->isBombermanPresent()) {
-			SDL_RenderDrawRect(renderer, this->getRect());
-		}
-	}
+	Entity::render(batch);
 }
 
 bool Tile::destroyWall(Game* game) {
-	if (!indestructible && wall) {
+	if (!isIndestructible() && isWall()) {
 		setWall(false);
 		createPowerup(game);
 		
-		Particle* destructionEffect = TextureManager::createWallDestructionEffect();
-		destructionEffect->centerInRect(*this->getRect());
-		game->entityManager->addEntity(destructionEffect);
+		//Visual effects are skipped in headless games, the animation frames are not loaded there
+		if (!game->isHeadless()) {
+			game->particleSystem->addWallDestruction(*this->getRect());
+		}
 		
 		return true;
 	}
@@ -63,37 +51,32 @@ bool Tile::destroyWall(Game* game) {
 }
 
 bool Tile::isDangerous() const {
-	if (bombPlaced) {
-		return true;
-	}
-	if (ticksToExplosion > 0 && ticksToExplosion < 64) {
-		return true;
-	}
-	return false;
+	return map->isDangerous(index);
 }
 
-bool Tile::equals(Tile* tile) const {
-	return ((this->getX() == tile->getX()) && (this->getY() == tile->getY()));
+bool Tile::equals(const Tile* tile) const {
+	return index == tile->index;
 }
 
 void Tile::createPowerup(Game* game) const {
+	Random& random = game->getPowerUpRandom();
 	std::shared_ptr<Entity> newPowerUp;
-	if (Utils::getRandomIntNumberInRange(0, 100) < Constants::POWERUP_DROP_CHANCE) {
-		const int typeChance = Utils::getRandomIntNumberInRange(0, 100);
+	if (random.getIntInRange(0, 100) < Constants::POWERUP_DROP_CHANCE) {
+		const int typeChance = random.getIntInRange(0, 100);
 		if (typeChance < 45) {
-			if (Utils::getRandomIntNumberInRange(0, 100) < Constants::NEGATIVE_POWERUP_CHANCE) {
+			if (random.getIntInRange(0, 100) < Constants::NEGATIVE_POWERUP_CHANCE) {
 				newPowerUp = std::make_shared<BombCountModifier>(BombCountModifier(-1, this->getX(), this->getY()));
 			} else {
 				newPowerUp = std::make_shared<BombCountModifier>(BombCountModifier(1, this->getX(), this->getY()));
 			}
 		} else if (typeChance < 90) {
-			if (Utils::getRandomIntNumberInRange(0, 100) < Constants::NEGATIVE_POWERUP_CHANCE) {
+			if (random.getIntInRange(0, 100) < Constants::NEGATIVE_POWERUP_CHANCE) {
 				newPowerUp = std::make_shared<BombPowerModifier>(BombPowerModifier(-1, this->getX(), this->getY()));
 			} else {
 				newPowerUp = std::make_shared<BombPowerModifier>(BombPowerModifier(1, this->getX(), this->getY()));
 			}
 		} else {
-			if (Utils::getRandomIntNumberInRange(0, 100) < 70) {
+			if (random.getIntInRange(0, 100) < 70) {
 				newPowerUp = std::make_shared<HealthPickup>(HealthPickup(this->getX(), this->getY()));
 			} else {
 				newPowerUp = std::make_shared<SpeedPowerUp>(SpeedPowerUp(this->getX(), this->getY()));
@@ -104,59 +87,61 @@ void Tile::createPowerup(Game* game) const {
 	}	
 }
 
-bool Tile::isWall() const {
-	return wall;
+int Tile::getIndex() const {
+	return index;
 }
 
-void Tile::setWall(bool wall) {
-	this->wall = wall;
-	this->setCollidable(wall);
+int Tile::getColumn() const {
+	return column;
 }
 
-bool Tile::isIndestructible() const {
-	return indestructible;
+int Tile::getRow() const {
+	return row;
 }
 
-void Tile::setIndestructible(bool indestructible) {
-	this->indestructible = indestructible;
+void Tile::setMap(Map* map) {
+	this->map = map;
 }
 
-bool Tile::isEdgeWall() const {
-	return indestructible;
+bool Tile::isWall() const {
+	return map->isWall(index);
 }
 
-void Tile::setEdgeWall(bool edgewall) {
-	this->edgeWall = edgewall;
+void Tile::setWall(bool wall) {
+	map->setWall(index, wall);
 }
 
-bool Tile::isOverrideWalkable() const {
-	return overrideWalkable;
+bool Tile::isIndestructible() const {
+	return map->isIndestructible(index);
 }
 
-void Tile::setOverrideWalkable(bool overrideWalkable) {
-	this->overrideWalkable = overrideWalkable;
+void Tile::setIndestructible(bool indestructible) {
+	map->setIndestructible(index, indestructible);
 }
 
-bool Tile::isBombPlaced() const {
-	return bombPlaced;
+bool Tile::isEdgeWall() const {
+	return map->isIndestructible(index);
 }
 
-void Tile::setBombPlaced(bool bombPlaced) {
-	this->bombPlaced = bombPlaced;
+void Tile::setEdgeWall(bool edgewall) {
+	if (this->edgeWall != edgewall) {
+		this->edgeWall = edgewall;
+		map->markTileDirty(index);
+	}
 }
 
-int Tile::getTicksToExplosion() const {
-	return ticksToExplosion;
+bool Tile::isBombPlaced() const {
+	return map->isBombPlaced(index);
 }
 
-void Tile::setTicksToExplosion(int ticksToExplosion) {
-	this->ticksToExplosion = ticksToExplosion;
+int Tile::getTicksToExplosion() const {
+	return map->getTicksToExplosion(index);
 }
 
 bool Tile::isBombermanPresent() const {
-	return bombermanPresent;
+	return map->isBombermanPresent(index);
 }
 
 void Tile::setBombermanPresent(bool bombermanPresent) {
-	this->bombermanPresent = bombermanPresent;
+	map->setBombermanPresent(index, bombermanPresent);
 }
\ No newline at end of file
@@ -1,50 +1,35 @@
 #pragma once
 
-#include "TilePathfindingData.h"
-
 #include "Entity.h"
 
-class EntityManager;
 class Map;
 
 /*!
  * A tile of the map. A tile can be empty or function as a wall.
+ * Tiles are owned by the map, the tile state is stored in packed arrays of the map
+ * and the tile getters and setters forward to them.
  */
 class Tile : public Entity {
 private:
-	/*! Whether this tile acts as a solid wall rather than empty space. */
-	bool wall = false;
+	/*! The map owning this tile. */
+	Map* map;
+
+	/*! Index of the tile in the row-major tile storage of the map. */
+	int index;
 
-	/*! Whether the wall of this tile is invulnerable to bomb explosions. */
-	bool indestructible = false;
+	/*! Tile column and row in the map grid. */
+	int column;
+	int row;
 	
 	/*! Determines if this wall acts as an map edge wall. Currently just changes its texture. */
 	bool edgeWall = false;
-
-	/*! Utility flag for enabling pathfinding algorithms to ignore walls of this tile. */
-	bool overrideWalkable = false;
-	
-	/*! Whether a bomb is placed on this tile. */
-	bool bombPlaced = false;
-
-	/*! Whether a bomberman is on this tile. */
-	bool bombermanPresent = false;
-
-	/*!
-	 * Game ticks remaining until a bomb explodes.
-	 * Tick of 0 would mean that no bombs are currently about to explode near it.
-	 */
-	int ticksToExplosion = 0;
 public:
-	Tile(int initialX, int initialY);
-
 	/*!
-	 * \see TilePathfindingData
+	 * Creates a tile at the specified grid position of a map.
 	 */
-	TilePathfindingData pathfindingData;
+	Tile(Map* map, int column, int row, int tileSize);
 
-	void update(Game* game) override;
-	void render(SDL_Renderer* renderer) override;
+	void render(SpriteBatch& batch) override;
 	
 	/*!
 	 * Destroys the wall of the tile if a wall is present.
@@ -59,17 +44,26 @@ public:
 	bool isDangerous() const;
 
 	/*!
-	 * Compares two tiles based on their coordinates.
+	 * Compares two tiles based on their position in the map grid.
 	 *
-	 * \return true if their coordinates are the same.
+	 * \return true if their positions are the same.
 	 */
-	bool equals(Tile* tile) const;
+	bool equals(const Tile* tile) const;
 private:
 	/*!
 	 * Creates a random powerup at the tile location.
 	 */
 	void createPowerup(Game* game) const;
 public:
+	int getIndex() const;
+	int getColumn() const;
+	int getRow() const;
+
+	/*!
+	 * Sets the map owning this tile, used when the map copies its tiles.
+	 */
+	void setMap(Map* map);
+
 	bool isWall() const;
 	void setWall(bool wall);
 
@@ -79,14 +73,9 @@ public:
 	bool isEdgeWall() const;
 	void setEdgeWall(bool edgewall);
 
-	bool isOverrideWalkable() const;
-	void setOverrideWalkable(bool overrideWalkable);
-
 	bool isBombPlaced() const;
-	void setBombPlaced(bool bombPlaced);
 
 	int getTicksToExplosion() const;
-	void setTicksToExplosion(int ticksToExplosion);
 
 	bool isBombermanPresent() const;
 	void setBombermanPresent(bool bombermanPresent);
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "SDL.h"
+
+#include <vector>
+
+/*!
+ * A connection to the other peer of a network match.
+ *
+ * A transport delivers packets like UDP datagrams: packets arrive whole, but may be lost, duplicated or reordered,
+ * the protocol running on top of the transport has to cope with that.
+ * Neither sending nor receiving blocks.
+ * \see LockstepSession
+ */
+class Transport {
+public:
+	virtual ~Transport() = default;
+
+	/*!
+	 * Sends a packet to the peer.
+	 *
+	 * \throws std::runtime_error
+	 */
+	virtual void send(const std::vector<Uint8>& packet) = 0;
+
+	/*!
+	 * Receives the next packet from the peer.
+	 *
+	 * \param packet Overwritten with the received packet.
+	 * \return true if a packet was received, false if no packet is waiting.
+	 * \throws std::runtime_error
+	 */
+	virtual bool receive(std::vector<Uint8>& packet) = 0;
+};
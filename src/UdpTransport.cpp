@@ -0,0 +1,110 @@
+#include "UdpTransport.h"
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#ifndef _WIN32
+
+UdpTransport::UdpTransport(Uint16 localPort, const std::string& peerHost, Uint16 peerPort)
+: peerPort(peerPort), receiveBuffer(65536) {
+	addrinfo hints;
+	std::memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_DGRAM;
+	addrinfo* result = nullptr;
+	const int error = getaddrinfo(peerHost.c_str(), nullptr, &hints, &result);
+	if (error != 0 || !result) {
+		std::ostringstream oss;
+		oss << "Failed to resolve the peer address " << peerHost << " (" << gai_strerror(error) << ")" << std::endl;
+		throw std::runtime_error(oss.str());
+	}
+	peerAddress = reinterpret_cast<sockaddr_in*>(result->ai_addr)->sin_addr.s_addr;
+	freeaddrinfo(result);
+
+	socketHandle = socket(AF_INET, SOCK_DGRAM, 0);
+	if (socketHandle < 0) {
+		std::ostringstream oss;
+		oss << "Failed to open a UDP socket (" << std::strerror(errno) << ")" << std::endl;
+		throw std::runtime_error(oss.str());
+	}
+
+	sockaddr_in localAddress;
+	std::memset(&localAddress, 0, sizeof(localAddress));
+	localAddress.sin_family = AF_INET;
+	localAddress.sin_addr.s_addr = htonl(INADDR_ANY);
+	localAddress.sin_port = htons(localPort);
+	if (bind(socketHandle, reinterpret_cast<sockaddr*>(&localAddress), sizeof(localAddress)) != 0
+		|| fcntl(socketHandle, F_SETFL, fcntl(socketHandle, F_GETFL, 0) | O_NONBLOCK) != 0) {
+		std::ostringstream oss;
+		oss << "Failed to bind the UDP port " << localPort << " (" << std::strerror(errno) << ")" << std::endl;
+		close(socketHandle);
+		throw std::runtime_error(oss.str());
+	}
+}
+
+UdpTransport::~UdpTransport() {
+	close(socketHandle);
+}
+
+void UdpTransport::send(const std::vector<Uint8>& packet) {
+	sockaddr_in address;
+	std::memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = peerAddress;
+	address.sin_port = htons(peerPort);
+	//A datagram that could not be sent is a lost packet, which the protocol recovers from
+	sendto(socketHandle, packet.data(), packet.size(), 0, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+}
+
+bool UdpTransport::receive(std::vector<Uint8>& packet) {
+	while (true) {
+		sockaddr_in address;
+		socklen_t addressLength = sizeof(address);
+		const ssize_t size = recvfrom(socketHandle, receiveBuffer.data(), receiveBuffer.size(), 0,
+			reinterpret_cast<sockaddr*>(&address), &addressLength);
+		if (size < 0) {
+			if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ECONNREFUSED) {
+				return false;
+			}
+			std::ostringstream oss;
+			oss << "Failed to receive a UDP datagram (" << std::strerror(errno) << ")" << std::endl;
+			throw std::runtime_error(oss.str());
+		}
+		//Datagrams of anyone else than the peer are dropped
+		if (address.sin_addr.s_addr == peerAddress && address.sin_port == htons(peerPort)) {
+			packet.assign(receiveBuffer.begin(), receiveBuffer.begin() + size);
+			return true;
+		}
+	}
+}
+
+#else
+
+UdpTransport::UdpTransport(Uint16 localPort, const std::string& peerHost, Uint16 peerPort) {
+	throw std::runtime_error("The UDP transport is not supported on Windows\n");
+}
+
+UdpTransport::~UdpTransport() {
+
+}
+
+void UdpTransport::send(const std::vector<Uint8>& packet) {
+
+}
+
+bool UdpTransport::receive(std::vector<Uint8>& packet) {
+	return false;
+}
+
+#endif
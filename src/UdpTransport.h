@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Transport.h"
+
+#include <string>
+
+/*!
+ * A transport sending the packets to the peer as UDP datagrams over IPv4.
+ *
+ * The socket is bound to a local port and only datagrams coming from the peer address are received.
+ * Only POSIX sockets are supported, creating the transport on Windows throws.
+ */
+class UdpTransport : public Transport {
+private:
+	int socketHandle = -1;
+	/*! IPv4 address of the peer in network byte order. */
+	Uint32 peerAddress = 0;
+	Uint16 peerPort = 0;
+	/*! Buffer the size of the largest UDP datagram. */
+	std::vector<Uint8> receiveBuffer;
+public:
+	/*!
+	 * Opens a non-blocking socket bound to the local port.
+	 *
+	 * \param localPort Port the peer sends the packets to.
+	 * \param peerHost Host name or IPv4 address of the peer.
+	 * \param peerPort Port the peer is bound to.
+	 * \throws std::runtime_error
+	 */
+	UdpTransport(Uint16 localPort, const std::string& peerHost, Uint16 peerPort);
+
+	~UdpTransport() override;
+
+	UdpTransport(const UdpTransport&) = delete;
+	UdpTransport& operator= (const UdpTransport&) = delete;
+
+	void send(const std::vector<Uint8>& packet) override;
+	bool receive(std::vector<Uint8>& packet) override;
+};
@@ -141,19 +141,4 @@ public:
 	static int range(int OldValue, int OldMin, int OldMax, int NewMin, int NewMax) {
 		return (((OldValue - OldMin) * (NewMax - NewMin)) / (OldMax - OldMin)) + NewMin;
 	}
-
-	/*!
-	 * Returns a pseudo-random number in the specified inclusive number range.
-	 * If min is greater than max, min and max are switched.
-	 */
-	static int getRandomIntNumberInRange(int min, int max) {
-		if (min > max) {
-			int tmp = min;
-			min = max;
-			max = tmp;
-			std::cout << "Random number min/max switched!" << std::endl;
-		}
-		
-		return (rand() % (max - min + 1)) + min;
-	}
 };
@@ -0,0 +1,79 @@
+#include "WorkerPool.h"
+
+WorkerPool::WorkerPool(unsigned int threadCount) {
+	if (threadCount == 0) {
+		threadCount = std::thread::hardware_concurrency();
+	}
+	for (unsigned int i = 1; i < threadCount; i++) {
+		workers.emplace_back(&WorkerPool::workerLoop, this);
+	}
+}
+
+WorkerPool::~WorkerPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	jobAvailable.notify_all();
+	for (auto& worker : workers) {
+		worker.join();
+	}
+}
+
+void WorkerPool::run(std::size_t count, const std::function<void(std::size_t)>& job) {
+	//Not worth waking up the workers for a single index
+	if (workers.empty() || count <= 1) {
+		for (std::size_t i = 0; i < count; i++) {
+			job(i);
+		}
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		this->job = &job;
+		jobSize = count;
+		nextIndex = 0;
+		busyWorkers = workers.size();
+		generation++;
+	}
+	jobAvailable.notify_all();
+
+	processJob();
+
+	std::unique_lock<std::mutex> lock(mutex);
+	jobFinished.wait(lock, [this] { return busyWorkers == 0; });
+	this->job = nullptr;
+}
+
+unsigned int WorkerPool::getThreadCount() const {
+	return static_cast<unsigned int>(workers.size()) + 1;
+}
+
+void WorkerPool::workerLoop() {
+	unsigned int finishedGeneration = 0;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			jobAvailable.wait(lock, [this, finishedGeneration] { return stopping || generation != finishedGeneration; });
+			if (stopping) {
+				return;
+			}
+			finishedGeneration = generation;
+		}
+
+		processJob();
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			busyWorkers--;
+		}
+		jobFinished.notify_one();
+	}
+}
+
+void WorkerPool::processJob() {
+	for (std::size_t i = nextIndex++; i < jobSize; i = nextIndex++) {
+		(*job)(i);
+	}
+}
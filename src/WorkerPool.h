@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <cstddef>
+
+/*!
+ * A fixed set of worker threads that run indexed jobs in parallel.
+ *
+ * The calling thread takes part in every job, so a pool with a thread count of 1 has no workers
+ * and runs the jobs serially on the calling thread.
+ */
+class WorkerPool {
+private:
+	std::vector<std::thread> workers;
+
+	std::mutex mutex;
+	std::condition_variable jobAvailable;
+	std::condition_variable jobFinished;
+
+	/*! The job of the current run, called with every index in [0, jobSize). */
+	const std::function<void(std::size_t)>* job = nullptr;
+	std::size_t jobSize = 0;
+	/*! The next index of the current job that was not taken by any thread yet. */
+	std::atomic<std::size_t> nextIndex{0};
+
+	/*! Incremented on every run so the workers can tell a new job from a spurious wake up. */
+	unsigned int generation = 0;
+	/*! Number of workers that did not finish the current job yet. */
+	std::size_t busyWorkers = 0;
+	bool stopping = false;
+public:
+	/*!
+	 * Creates a worker pool.
+	 * \param threadCount Total number of threads running a job including the calling thread.
+	 *	0 uses one thread per hardware thread.
+	 */
+	explicit WorkerPool(unsigned int threadCount);
+
+	~WorkerPool();
+
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator= (const WorkerPool&) = delete;
+
+	/*!
+	 * Calls the job with every index from 0 to count - 1, spread across the threads of the pool.
+	 * Returns once all indexes were processed. The order in which the indexes are processed is unspecified
+	 * and the job must not throw.
+	 */
+	void run(std::size_t count, const std::function<void(std::size_t)>& job);
+
+	/*!
+	 * Returns the total number of threads running a job including the calling thread.
+	 */
+	unsigned int getThreadCount() const;
+private:
+	void workerLoop();
+
+	/*!
+	 * Processes indexes of the current job until none are left.
+	 */
+	void processJob();
+};
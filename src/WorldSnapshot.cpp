@@ -0,0 +1,92 @@
+#include "WorldSnapshot.h"
+
+#include "Bomb.h"
+#include "BombCountModifier.h"
+#include "BombPowerModifier.h"
+#include "SpeedPowerUp.h"
+#include "HealthPickup.h"
+#include "DamageCollider.h"
+
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<EntityState>::value, "Entity states are copied as plain data");
+
+std::shared_ptr<Entity> EntityState::createEntity(const EntityState& state) {
+	const int x = state.position.x;
+	const int y = state.position.y;
+	switch (state.type) {
+		case BOMB:
+			return std::make_shared<Bomb>(state.bomb.bombPowerLevel, x, y);
+		case BOMB_COUNT_MODIFIER:
+			return std::make_shared<BombCountModifier>(state.collectable.amount, x, y);
+		case BOMB_POWER_MODIFIER:
+			return std::make_shared<BombPowerModifier>(state.collectable.amount, x, y);
+		case SPEED_POWER_UP:
+			return std::make_shared<SpeedPowerUp>(x, y);
+		case HEALTH_PICKUP:
+			return std::make_shared<HealthPickup>(x, y);
+		case DAMAGE_COLLIDER:
+			return std::make_shared<DamageCollider>(state.collectable.ticksToVanish, x, y, state.position.w, state.position.h);
+		case PLAYER:
+		case COMPUTER:
+			break;
+	}
+	return nullptr;
+}
+
+void WorldSnapshot::clear() {
+	entities.clear();
+	collidingEntities.clear();
+}
+
+SnapshotRing::SnapshotRing(size_t capacity)
+: snapshots(capacity) {
+
+}
+
+WorldSnapshot& SnapshotRing::push() {
+	WorldSnapshot& snapshot = snapshots[next];
+	next = (next + 1) % snapshots.size();
+	if (count < snapshots.size()) {
+		count++;
+	}
+	return snapshot;
+}
+
+const WorldSnapshot* SnapshotRing::findTick(unsigned int tick) const {
+	for (size_t age = 0; age < count; age++) {
+		const WorldSnapshot& snapshot = getByAge(age);
+		if (snapshot.tick <= tick) {
+			return &snapshot;
+		}
+	}
+	return nullptr;
+}
+
+const WorldSnapshot* SnapshotRing::getOldest() const {
+	return count > 0 ? &getByAge(count - 1) : nullptr;
+}
+
+void SnapshotRing::discardAfter(unsigned int tick) {
+	while (count > 0 && getByAge(0).tick > tick) {
+		next = (next + snapshots.size() - 1) % snapshots.size();
+		count--;
+	}
+}
+
+void SnapshotRing::clear() {
+	next = 0;
+	count = 0;
+}
+
+size_t SnapshotRing::getCount() const {
+	return count;
+}
+
+size_t SnapshotRing::getCapacity() const {
+	return snapshots.size();
+}
+
+const WorldSnapshot& SnapshotRing::getByAge(size_t age) const {
+	return snapshots[(next + snapshots.size() - 1 - age) % snapshots.size()];
+}
@@ -0,0 +1,198 @@
+#pragma once
+
+#include "SDL.h"
+
+#include "EntityHandle.h"
+#include "DangerMap.h"
+#include "Random.h"
+
+#include <memory>
+#include <vector>
+
+class Entity;
+
+/*!
+ * The simulation state of a single entity.
+ *
+ * Every entity type writes the fields of its class and its base classes, fields of other types are left untouched.
+ * The state is a plain copyable struct, pointers are stored as entity handles and tile indexes.
+ * \see Entity::saveState()
+ */
+struct EntityState {
+	/*! Type the entity is recreated as. */
+	enum Type : Uint8 {
+		PLAYER, COMPUTER, BOMB,
+		BOMB_COUNT_MODIFIER, BOMB_POWER_MODIFIER, SPEED_POWER_UP, HEALTH_PICKUP,
+		DAMAGE_COLLIDER
+	};
+
+	Type type;
+	/*! Handle of the entity, a null handle for dead bombermen that are no longer managed. */
+	EntityHandle handle;
+	SDL_Rect position;
+	bool collidable;
+	bool foregroundRender;
+	bool toBeRemoved;
+	bool renderingExternal;
+
+	struct {
+		SDL_Point movementDirection;
+		int speed;
+		bool collision;
+		/*! Range of the colliding entities in WorldSnapshot::collidingEntities. */
+		unsigned int collidingBegin;
+		unsigned int collidingCount;
+	} movable;
+
+	struct {
+		int health;
+		int maxHealth;
+		int score;
+		bool concussion;
+		int concussionTick;
+		int concussionDuration;
+		bool placeDownBombOnUpdate;
+		int maxBombs;
+		int availableBombs;
+		int placedBombs;
+		int bombPowerLevel;
+		/*! Tile index, -1 for none. */
+		int currentTile;
+	} bomberman;
+
+	struct {
+		char playerId;
+		Uint8 input;
+	} player;
+
+	struct {
+		int id;
+		bool getTheClosestPowerup;
+		int bombCooldownTick;
+		int updateLogicActiveDuration;
+		int updateLogicTick;
+		/* Tile indexes, -1 for none. */
+		int targetTile;
+		int bombPlacedTile;
+		int bombExitTile;
+		Random random;
+	} computer;
+
+	struct {
+		EntityHandle bomberman;
+		int bombPowerLevel;
+		int bombPenetration;
+		int ticksToExplosion;
+		bool registeredDanger;
+		bool isExploding;
+	} bomb;
+
+	struct {
+		bool vanishEnabled;
+		int ticksToVanish;
+		bool negative;
+		/*! Bomb count or bomb power change of a modifier. */
+		int amount;
+		/*! Owner of a damage collider. */
+		EntityHandle owner;
+	} collectable;
+
+	/*!
+	 * Creates an entity of the state type, the state itself is applied with Entity::restoreState().
+	 * Players and computers are never recreated, they are restored in place, nullptr is returned for them.
+	 */
+	static std::shared_ptr<Entity> createEntity(const EntityState& state);
+};
+
+/*!
+ * The complete simulation state of a game at the end of a tick.
+ *
+ * Restoring a snapshot puts the game into the exact state it was captured in, a game continued from a restored
+ * snapshot plays out the same way as it did from the original state given the same player inputs.
+ * Visual state, particles and sprite animations, is not part of a snapshot.
+ *
+ * A snapshot is reused, capturing into an existing snapshot only reallocates when the world grew.
+ * \see Game::captureSnapshot()
+ * \see Game::restoreSnapshot()
+ */
+struct WorldSnapshot {
+	unsigned int tick = 0;
+	bool endOfGame = false;
+
+	Random mapRandom;
+	Random powerUpRandom;
+
+	/* Packed tile state of the map, see Map. */
+	std::vector<unsigned char> wall;
+	std::vector<unsigned char> indestructible;
+	std::vector<unsigned char> bombermanPresent;
+	DangerMap dangerMap;
+
+	/* Handle table of the entity manager, see EntityManager. */
+	std::vector<unsigned int> slotGenerations;
+	std::vector<unsigned int> freeSlots;
+
+	/*! Managed entities in the update order, followed by the dead bombermen. */
+	std::vector<EntityState> entities;
+	/*! Entities the movables are colliding with, indexed by the movable states. */
+	std::vector<EntityHandle> collidingEntities;
+
+	/*!
+	 * Empties the entity lists, keeping their memory for the next capture.
+	 */
+	void clear();
+};
+
+/*!
+ * Snapshots of the last ticks of a game in a ring buffer.
+ * All snapshots are allocated when the ring is created and are overwritten from the oldest one,
+ * so keeping the history does not allocate once the snapshots reached the size of the world.
+ */
+class SnapshotRing {
+private:
+	std::vector<WorldSnapshot> snapshots;
+	/*! Index of the slot the next snapshot is written to. */
+	size_t next = 0;
+	/*! Number of stored snapshots. */
+	size_t count = 0;
+public:
+	/*!
+	 * Creates a ring keeping up to capacity snapshots.
+	 */
+	explicit SnapshotRing(size_t capacity);
+
+	/*!
+	 * Returns the snapshot to capture the next tick into, it replaces the oldest snapshot when the ring is full.
+	 */
+	WorldSnapshot& push();
+
+	/*!
+	 * Returns the newest snapshot of a tick not later than the specified tick.
+	 *
+	 * \return The snapshot, nullptr if all stored snapshots are later.
+	 */
+	const WorldSnapshot* findTick(unsigned int tick) const;
+
+	/*!
+	 * Returns the oldest stored snapshot, nullptr if the ring is empty.
+	 */
+	const WorldSnapshot* getOldest() const;
+
+	/*!
+	 * Discards all snapshots of ticks later than the specified tick, used after the game was rewound.
+	 */
+	void discardAfter(unsigned int tick);
+
+	/*!
+	 * Discards all snapshots.
+	 */
+	void clear();
+
+	size_t getCount() const;
+	size_t getCapacity() const;
+private:
+	/*!
+	 * Returns the stored snapshot by its age, 0 is the newest one.
+	 */
+	const WorldSnapshot& getByAge(size_t age) const;
+};
@@ -1,24 +1,43 @@
 #include "Game.h"
 
 #include <iostream>
+#include <string>
+#include <stdexcept>
 
 /*!
  * Project main method
  */
 int main(int argc, char* argv[]) {
-	//Loading config argument
+	//Loading arguments
 	char* configPath = nullptr;
-	if (argc >= 2) {
-		if (argc == 2) {
-			configPath = argv[1];
+	bool headless = false;
+	bool seedSpecified = false;
+	unsigned long long seed = 0;
+	for (int i = 1; i < argc; i++) {
+		if (std::string(argv[i]) == "--headless") {
+			headless = true;
+		} else if (std::string(argv[i]) == "--seed" && i + 1 < argc) {
+			try {
+				seed = std::stoull(argv[++i]);
+				seedSpecified = true;
+			} catch (const std::logic_error& e) {
+				std::cerr << "Invalid seed " << argv[i] << std::endl;
+				return 1;
+			}
+		} else if (!configPath) {
+			configPath = argv[i];
 		} else {
-			std::cerr << "Invalid arguments! Usage: <executable name> <config file path>" << std::endl;
+			std::cerr << "Invalid arguments! Usage: <executable name> [--headless] [--seed number] [config file path]" << std::endl;
 			return 1;
 		}
 	}
 
 	//Starting the game
 	std::unique_ptr<Game> game = std::make_unique<Game>();
+	game->setHeadless(headless);
+	if (seedSpecified) {
+		game->setSeed(seed);
+	}
 	if (!game->run(configPath)) {
 		return 1;
 	}